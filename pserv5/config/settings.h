@@ -35,6 +35,10 @@ namespace pserv
 
             /// @brief Sort direction: true for ascending, false for descending.
             TypedValue<bool> sortAscending{this, "SortAscending", true};
+
+            /// @brief Comma-separated multi-column sort order, e.g. "3,-1" (column indices, '-' for descending).
+            /// The first key is mirrored in sortColumn/sortAscending.
+            TypedValue<std::string> sortSpecs{this, "SortSpecs", ""};
         };
 
         /// @brief Root configuration section containing all application settings.
@@ -106,6 +110,16 @@ namespace pserv
                 TypedValue<bool> pauseDuringEdits{this, "PauseDuringEdits", true};
             } autoRefresh{this};
 
+            struct PerformanceSettings : public Section
+            {
+                PerformanceSettings(Section *pParent)
+                    : Section{pParent, "Performance"}
+                {
+                }
+                TypedValue<int32_t> parallelSortThreshold{this, "ParallelSortThreshold", 8192}; // Rows; 0 = never sort in parallel
+                TypedValue<int32_t> processDetailThreads{this, "ProcessDetailThreads", 8};         // Threads reading process user/path/command line; 1 = sequential
+            } performance{this};
+
             DisplayTable *getSectionFor(const std::string &name);
 
         private:
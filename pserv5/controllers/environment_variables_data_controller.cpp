@@ -24,15 +24,12 @@ namespace pserv
         {
             // Note: We don't call Clear() here - StartRefresh/FinishRefresh handles
             // update-in-place for existing objects and removes stale ones
-            m_objects.StartRefresh();
+            StartRefresh();
             EnvironmentVariableManager::EnumerateEnvironmentVariables(&m_objects);
             m_objects.FinishRefresh();
 
-            // Re-apply last sort order if any
-            if (m_lastSortColumn >= 0)
-            {
-                Sort(m_lastSortColumn, m_lastSortAscending);
-            }
+            // Re-apply sort order (only changed objects are moved)
+            m_objects.Resort();
 
             spdlog::info("Successfully refreshed {} environment variables", m_objects.GetSize());
             SetLoaded();
@@ -238,7 +235,7 @@ namespace pserv
                     std::string lowerName = name;
                     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
                     bool exists = false;
-                    for (const auto *obj : m_objects)
+                    for (const auto *obj : *GetSnapshot())
                     {
                         const auto *envVar = static_cast<const EnvironmentVariableInfo *>(obj);
                         std::string existingName = envVar->GetName();
@@ -19,6 +19,10 @@ namespace pserv
                   {"Path", "Path", ColumnDataType::String},
                   {"Process ID", "ProcessID", ColumnDataType::UnsignedInteger}}}
     {
+#ifndef PSERV_CONSOLE_BUILD
+        // Thousands of rows, filtered interactively; pservc filters once and would not recover the build cost
+        EnableTextIndex();
+#endif
     }
 
     void ModulesDataController::Refresh(bool isAutoRefresh)
@@ -30,14 +34,18 @@ namespace pserv
         // Note: We don't call Clear() here - StartRefresh/FinishRefresh handles
         // update-in-place for existing objects and removes stale ones
         DataObjectContainer processes;
-        ProcessManager::EnumerateProcesses(&processes);
-        m_objects.StartRefresh();
+        // Only the PIDs are needed, not user, path and command line
+        ProcessManager::EnumerateProcesses(&processes, {.bAllProcesses = false});
+        StartRefresh();
         for (auto proc : processes)
         {
             // Enumerate modules for this process
             ModuleManager::EnumerateModules(&m_objects, static_cast<ProcessInfo*>(proc)->GetPid());
         }
         m_objects.FinishRefresh();
+
+        // Re-apply sort order (only changed objects are moved)
+        m_objects.Resort();
         spdlog::info("Refreshed {} modules from {} processes", m_objects.GetSize(), processes.GetSize());
         SetLoaded();
     }
@@ -29,15 +29,12 @@ namespace pserv
         {
             // Note: We don't call Clear() here - StartRefresh/FinishRefresh handles
             // update-in-place for existing objects and removes stale ones
-            m_objects.StartRefresh();
+            StartRefresh();
             NetworkConnectionManager::EnumerateConnections(&m_objects);
             m_objects.FinishRefresh();
 
-            // Re-apply last sort order if any
-            if (m_lastSortColumn >= 0)
-            {
-                Sort(m_lastSortColumn, m_lastSortAscending);
-            }
+            // Re-apply sort order (only changed objects are moved)
+            m_objects.Resort();
 
             spdlog::info("Successfully refreshed {} network connections", m_objects.GetSize());
             SetLoaded();
@@ -6,6 +6,7 @@
 #include <utils/string_utils.h>
 #include <utils/win32_error.h>
 #include <windows_api/process_manager.h>
+#include <windows_api/sid_name_cache.h>
 
 namespace pserv
 {
@@ -29,40 +30,84 @@ namespace pserv
                   {"User Time", "UserCPUTime", ColumnDataType::Time},
                   {"Paged Pool", "PagedPoolUsage", ColumnDataType::Size},
                   {"Non-Paged Pool", "NonPagedPoolUsage", ColumnDataType::Size},
-                  {"Page Faults", "PageFaultCount", ColumnDataType::UnsignedInteger}}}
+                  {"Page Faults", "PageFaultCount", ColumnDataType::UnsignedInteger}}},
+          m_detailsCache{ProcessManager::CreateDetailsProvider()}
     {
+        AddAggregate("working set", ColumnDataType::Size);
+#ifndef PSERV_CONSOLE_BUILD
+        // Until the UI reports the rows on screen, load nothing (pservc prints everything, so it keeps the default)
+        m_detailsRequest.bAllProcesses = false;
+#endif
+    }
+
+    bool ProcessesDataController::SetObjectsOfInterest(std::vector<StableKey> stableKeys, bool bFiltered)
+    {
+        // Filtering or sorting by user, path or command line needs them for every process
+        bool bAllProcesses{bFiltered};
+        for (const auto &sortSpec : GetSortSpecs())
+        {
+            const auto property = static_cast<ProcessProperty>(sortSpec.ColumnIndex);
+            bAllProcesses |= property == ProcessProperty::User || property == ProcessProperty::Path || property == ProcessProperty::CommandLine;
+        }
+
+        const auto lacksDetails = [](const DataObject *dataObject) { return dataObject != nullptr && !static_cast<const ProcessInfo *>(dataObject)->HasDetails(); };
+        const auto snapshot = GetSnapshot();
+        const bool bMissing = bAllProcesses ? std::ranges::any_of(*snapshot, lacksDetails)
+                                            : std::ranges::any_of(stableKeys, [&](const StableKey &key) { return lacksDetails(snapshot->Find(key)); });
+
+        std::lock_guard lock{m_detailsMutex};
+        m_detailsRequest.bAllProcesses = bAllProcesses;
+        m_detailsRequest.StableKeys.clear();
+        m_detailsRequest.StableKeys.insert(stableKeys.begin(), stableKeys.end());
+        return bMissing;
     }
 
     void ProcessesDataController::Refresh(bool isAutoRefresh)
     {
         spdlog::info("Refreshing processes...");
 
-        // Query current user name (always, in case of user switch)
-        m_currentUserName.clear();
-        char buffer[256];
-        DWORD size = sizeof(buffer);
-        if (GetUserNameA(buffer, &size))
+        // Query current user name (on manual refreshes, in case of user switch). Auto-refreshes
+        // run on a worker thread while GetVisualState() reads the name, so they leave it alone.
+        if (!isAutoRefresh)
         {
-            m_currentUserName = buffer;
-        }
-        else
-        {
-            LogExpectedWin32Error("GetUserNameA");
+            std::string userName;
+            char buffer[256];
+            DWORD size = sizeof(buffer);
+            if (GetUserNameA(buffer, &size))
+            {
+                userName = buffer;
+            }
+            else
+            {
+                LogExpectedWin32Error("GetUserNameA");
+            }
+            if (userName != m_currentUserName)
+            {
+                // Decides which processes are highlighted
+                m_currentUserName = std::move(userName);
+                InvalidateStatistics();
+            }
         }
 
         try
         {
             // Note: We don't call Clear() here - StartRefresh/FinishRefresh handles
             // update-in-place for existing objects and removes stale ones
-            m_objects.StartRefresh();
-            ProcessManager::EnumerateProcesses(&m_objects);
-            m_objects.FinishRefresh();
-
-            // Re-apply sort
-            if (m_lastSortColumn >= 0)
+            StartRefresh();
+            // Names that arrive after this point are picked up by the next refresh
+            m_sidNamesRevision = SidNameCache::GetInstance().GetRevision();
+            ProcessDetailsRequest request;
             {
-                Sort(m_lastSortColumn, m_lastSortAscending);
+                std::lock_guard lock{m_detailsMutex};
+                request = m_detailsRequest;
             }
+            // Keeps what earlier refreshes loaded for processes that are no longer of interest
+            request.pCache = &m_detailsCache;
+            ProcessManager::EnumerateProcesses(&m_objects, request);
+            m_objects.FinishRefresh();
+
+            // Re-apply sort order (only changed objects are moved)
+            m_objects.Resort();
 
             spdlog::info("Refreshed {} processes", m_objects.GetSize());
             SetLoaded();
@@ -120,5 +165,23 @@ namespace pserv
 
         return VisualState::Normal;
     }
+
+    bool ProcessesDataController::HasPendingLazyFields() const
+    {
+        // Account names are looked up in the background, until then the SID is shown
+        return SidNameCache::GetInstance().GetRevision() != m_sidNamesRevision;
+    }
+
+    bool ProcessesDataController::IsVisualStateKnown(const DataObject *dataObject) const
+    {
+        // Highlighting and disabling depend on the owner, which is one of the lazily loaded details
+        return static_cast<const ProcessInfo *>(dataObject)->HasDetails();
+    }
+
+    uint64_t ProcessesDataController::GetAggregateValue(const DataObject *dataObject, size_t aggregateIndex) const
+    {
+        // The only aggregate: total working set
+        return static_cast<const ProcessInfo *>(dataObject)->GetWorkingSetSize();
+    }
    
 } // namespace pserv
\ No newline at end of file
@@ -2,9 +2,10 @@
 /// @brief Controller for running processes enumeration.
 ///
 /// Provides viewing and management of running processes using the
-/// Windows Tool Help and process APIs.
+/// Windows native process list and process APIs.
 #pragma once
 #include <core/data_controller.h>
+#include <windows_api/process_manager.h>
 
 namespace pserv
 {
@@ -16,11 +17,17 @@ namespace pserv
     /// - Executable path and owning user
     ///
     /// Processes owned by the current user are highlighted for easy identification.
+    /// User, path and command line are loaded only for the processes the user looks at,
+    /// or for all of them while they are filtered or sorted by these fields.
     class ProcessesDataController : public DataController
     {
     public:
         ProcessesDataController();
 
+        bool SetObjectsOfInterest(std::vector<StableKey> stableKeys, bool bFiltered) override;
+        bool HasPendingLazyFields() const override;
+        bool IsVisualStateKnown(const DataObject *dataObject) const override;
+
     private:
         void Refresh(bool isAutoRefresh = false) override;
         std::vector<const DataAction *> GetActions(const DataObject *dataObject) const override;
@@ -30,9 +37,15 @@ namespace pserv
 #endif
 
         VisualState GetVisualState(const DataObject *dataObject) const override;
+        uint64_t GetAggregateValue(const DataObject *dataObject, size_t aggregateIndex) const override;
 
     private:
         std::string m_currentUserName; ///< Cached username for highlighting own processes.
+
+        mutable std::mutex m_detailsMutex;       ///< Guards m_detailsRequest (set by the UI, read by refreshes).
+        ProcessDetailsRequest m_detailsRequest; ///< Processes whose user, path and command line are loaded.
+        ProcessDetailsCache m_detailsCache;     ///< User, path and command line of the running processes; used by Refresh() only.
+        std::atomic<uint64_t> m_sidNamesRevision{0}; ///< SidNameCache revision when the last refresh started.
     };
 
 } // namespace pserv
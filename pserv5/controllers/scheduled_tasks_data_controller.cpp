@@ -28,15 +28,12 @@ namespace pserv
         {
             // Note: We don't call Clear() here - StartRefresh/FinishRefresh handles
             // update-in-place for existing objects and removes stale ones
-            m_objects.StartRefresh();
+            StartRefresh();
             ScheduledTaskManager::EnumerateTasks(&m_objects);
             m_objects.FinishRefresh();
 
-            // Re-apply last sort order if any
-            if (m_lastSortColumn >= 0)
-            {
-                Sort(m_lastSortColumn, m_lastSortAscending);
-            }
+            // Re-apply sort order (only changed objects are moved)
+            m_objects.Resort();
 
             spdlog::info("Successfully refreshed {} scheduled tasks", m_objects.GetSize());
             SetLoaded();
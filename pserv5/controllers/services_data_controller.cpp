@@ -33,10 +33,13 @@ namespace pserv
                   {"Controls Accepted", "ControlsAccepted", ColumnDataType::String}}},
           m_serviceType{serviceType}
     {
+        AddAggregate("running", ColumnDataType::UnsignedInteger);
     }
 
     void ServicesDataController::SetMachineName(const std::string& machineName)
     {
+        // A running background refresh still reads the old name
+        WaitForBackgroundRefresh();
         m_machineName = machineName;
         spdlog::info("Services view will connect to machine: {}", m_machineName.empty() ? "local" : m_machineName);
     }
@@ -52,18 +55,15 @@ namespace pserv
             // Note: We don't call Clear() here - StartRefresh/FinishRefresh handles
             // update-in-place for existing objects and removes stale ones
             ServiceManager sm(m_machineName);
-            m_objects.StartRefresh();
+            StartRefresh();
             sm.EnumerateServices(&m_objects, m_serviceType, isAutoRefresh);
             m_objects.FinishRefresh();
 
             if (!isAutoRefresh)
                 spdlog::info("Successfully refreshed {} services", m_objects.GetSize());
 
-            // Re-apply last sort order if any
-            if (m_lastSortColumn >= 0)
-            {
-                Sort(m_lastSortColumn, m_lastSortAscending);
-            }
+            // Re-apply sort order (only changed objects are moved)
+            m_objects.Resort();
 
             SetLoaded();
         }
@@ -115,6 +115,12 @@ namespace pserv
         return VisualState::Normal;
     }
 
+    uint64_t ServicesDataController::GetAggregateValue(const DataObject *dataObject, size_t aggregateIndex) const
+    {
+        // The only aggregate: running services (set by ServiceInfo::SetCurrentState())
+        return dataObject->IsRunning() ? 1 : 0;
+    }
+
     void ServicesDataController::BeginPropertyEdits(DataObject *obj)
     {
         m_editingObject = obj;
@@ -59,6 +59,7 @@ namespace pserv
 #endif
 
         VisualState GetVisualState(const DataObject *service) const override;
+        uint64_t GetAggregateValue(const DataObject *dataObject, size_t aggregateIndex) const override;
 
         void BeginPropertyEdits(DataObject *obj) override;
         bool SetPropertyEdit(DataObject *obj, int columnIndex, const std::string &newValue) override;
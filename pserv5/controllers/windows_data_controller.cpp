@@ -29,10 +29,13 @@ namespace pserv
     {
         spdlog::info("Refreshing windows...");
 
-        m_objects.StartRefresh();
+        StartRefresh();
         WindowManager::EnumerateWindows(&m_objects);
         m_objects.FinishRefresh();
 
+        // Re-apply sort order (only changed objects are moved)
+        m_objects.Resort();
+
         spdlog::info("Refreshed {} windows", m_objects.GetSize());
         SetLoaded();
     }
@@ -0,0 +1,108 @@
+#include "precomp.h"
+#include <core/background_filter.h>
+
+namespace pserv
+{
+    BackgroundFilter::~BackgroundFilter()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_bShutdown = true;
+            m_queuedJob.reset();
+            m_runningStopSource.request_stop();
+        }
+        m_wakeup.notify_one();
+        if (m_worker.joinable())
+        {
+            m_worker.join();
+        }
+    }
+
+    bool BackgroundFilter::Update(
+        const std::shared_ptr<const DataObjectContainer> &snapshot, std::string_view filter, const std::vector<DataObjectColumn> &columns)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        bool bChanged = false;
+        if (m_finishedResult)
+        {
+            m_displayed = std::move(*m_finishedResult);
+            m_finishedResult.reset();
+            bChanged = true;
+        }
+
+        if (snapshot == m_requestedSnapshot && filter == m_requestedFilter && &columns == m_pRequestedColumns)
+        {
+            m_bFiltering = m_queuedJob.has_value() || m_bWorkerBusy;
+            return bChanged;
+        }
+        m_requestedSnapshot = snapshot;
+        m_requestedFilter = filter;
+        m_pRequestedColumns = &columns;
+
+        // Whatever is queued or running now computes an outdated result
+        m_queuedJob.reset();
+        m_runningStopSource.request_stop();
+
+        Job job{snapshot, std::string{filter}, &columns, std::stop_source{}};
+        if (!m_bWorkerBusy && (snapshot == nullptr || snapshot->GetSize() < BACKGROUND_ROW_THRESHOLD))
+        {
+            // Cheap enough for this frame; the idle worker leaves m_filter alone while we hold the lock
+            m_displayed = Run(job);
+            m_bFiltering = false;
+            return true;
+        }
+
+        m_queuedJob = std::move(job);
+        m_bFiltering = true;
+        if (!m_worker.joinable())
+        {
+            m_worker = std::thread{[this]() { WorkerMain(); }};
+        }
+        lock.unlock();
+        m_wakeup.notify_one();
+        return bChanged;
+    }
+
+    BackgroundFilter::Result BackgroundFilter::Run(const Job &job)
+    {
+        Result result;
+        result.Snapshot = job.Snapshot;
+        result.pColumns = job.pColumns;
+        result.Matches = m_filter.Apply(job.Snapshot, job.Filter, *job.pColumns, job.StopSource.get_token());
+        result.Query = m_filter.GetQuery();
+        return result;
+    }
+
+    void BackgroundFilter::WorkerMain()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        while (true)
+        {
+            m_wakeup.wait(lock, [this]() { return m_bShutdown || m_queuedJob.has_value(); });
+            if (m_bShutdown)
+                return;
+
+            Job job = std::move(*m_queuedJob);
+            m_queuedJob.reset();
+            m_runningStopSource = job.StopSource;
+            m_bWorkerBusy = true;
+            lock.unlock();
+
+            const auto startTime = std::chrono::steady_clock::now();
+            Result result = Run(job);
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+            lock.lock();
+            m_bWorkerBusy = false;
+            if (job.StopSource.stop_requested())
+            {
+                spdlog::debug("Filtering for '{}' cancelled after {} ms", job.Filter, elapsed.count());
+            }
+            else
+            {
+                spdlog::debug("Filtered {} of {} rows for '{}' in {} ms", result.Matches.size(), job.Snapshot->GetSize(), job.Filter, elapsed.count());
+                m_finishedResult = std::move(result);
+            }
+        }
+    }
+} // namespace pserv
@@ -0,0 +1,110 @@
+/// @file background_filter.h
+/// @brief Filter evaluation on a worker thread, so large views don't stall the render loop.
+///
+/// The UI calls Update() every frame with the current snapshot and filter
+/// text. Small snapshots are filtered right away on the calling thread, as
+/// before. For large ones the request is queued for a worker thread that runs
+/// an IncrementalFilter; a newer request (the next keystroke, a refresh or a
+/// sort) cancels the job still in flight. Until the new result is ready the
+/// previous one stays displayed, together with the snapshot it was computed
+/// for, so its objects remain valid.
+#pragma once
+
+#include <core/incremental_filter.h>
+
+namespace pserv
+{
+    /// @brief Filter result for the UI, computed in the background for large snapshots.
+    class BackgroundFilter final
+    {
+    public:
+        /// @brief Snapshots with fewer rows than this are filtered synchronously.
+        static constexpr size_t BACKGROUND_ROW_THRESHOLD = 20000;
+
+        BackgroundFilter() = default;
+        ~BackgroundFilter();
+
+        BackgroundFilter(const BackgroundFilter &) = delete;
+        BackgroundFilter &operator=(const BackgroundFilter &) = delete;
+        BackgroundFilter(BackgroundFilter &&) = delete;
+        BackgroundFilter &operator=(BackgroundFilter &&) = delete;
+
+        /// @brief Request the rows of a snapshot matching a filter, and pick up finished results.
+        /// Cheap if nothing changed since the last call; call it once per frame.
+        /// @param snapshot The latest snapshot.
+        /// @param filter Filter text (plain text or FilterQuery syntax).
+        /// @param columns Columns of the snapshot's controller; must outlive this object.
+        /// @return true if the displayed result changed.
+        bool Update(const std::shared_ptr<const DataObjectContainer> &snapshot, std::string_view filter, const std::vector<DataObjectColumn> &columns);
+
+        /// @brief Check whether a result for the last Update() is still being computed.
+        bool IsFiltering() const noexcept
+        {
+            return m_bFiltering;
+        }
+
+        /// @brief Check whether the displayed result belongs to a controller with these columns.
+        /// False after switching views until the first result for the new view is ready.
+        bool HasResultFor(const std::vector<DataObjectColumn> &columns) const noexcept
+        {
+            return m_displayed.pColumns == &columns;
+        }
+
+        /// @brief Get the snapshot the displayed result was computed for (may be older than the latest).
+        const std::shared_ptr<const DataObjectContainer> &GetSnapshot() const noexcept
+        {
+            return m_displayed.Snapshot;
+        }
+
+        /// @brief Get the displayed result: the matching objects of GetSnapshot(), in snapshot order.
+        std::span<DataObject *const> GetMatches() const noexcept
+        {
+            return m_displayed.Matches;
+        }
+
+        /// @brief Get the query of the displayed result (e.g. to show its error).
+        const FilterQuery &GetQuery() const noexcept
+        {
+            return m_displayed.Query;
+        }
+
+    private:
+        struct Job final
+        {
+            std::shared_ptr<const DataObjectContainer> Snapshot;
+            std::string Filter;
+            const std::vector<DataObjectColumn> *pColumns{nullptr};
+            std::stop_source StopSource;
+        };
+
+        struct Result final
+        {
+            std::shared_ptr<const DataObjectContainer> Snapshot;
+            const std::vector<DataObjectColumn> *pColumns{nullptr};
+            FilterQuery Query;
+            std::vector<DataObject *> Matches;
+        };
+
+        void WorkerMain();
+        Result Run(const Job &job);
+
+        // UI thread only
+        Result m_displayed;                                            ///< Result currently shown.
+        std::shared_ptr<const DataObjectContainer> m_requestedSnapshot; ///< Arguments of the last request...
+        std::string m_requestedFilter;                                 ///< ...
+        const std::vector<DataObjectColumn> *m_pRequestedColumns{nullptr}; ///< ...used to skip repeated requests.
+        bool m_bFiltering{false};                                      ///< The last request has no result yet.
+
+        // Shared with the worker, guarded by m_mutex
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;        ///< Signals a queued job or shutdown.
+        std::optional<Job> m_queuedJob;          ///< Next job for the worker.
+        std::stop_source m_runningStopSource;    ///< Stops the job the worker is running.
+        bool m_bWorkerBusy{false};               ///< The worker is running a job (and owns m_filter).
+        std::optional<Result> m_finishedResult;  ///< Completed job, not yet picked up by Update().
+        bool m_bShutdown{false};                 ///< Set by the destructor.
+
+        IncrementalFilter m_filter; ///< Used by the worker, or by Update() while the worker is idle.
+        std::thread m_worker;       ///< Started with the first background job.
+    };
+} // namespace pserv
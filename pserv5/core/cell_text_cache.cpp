@@ -0,0 +1,47 @@
+#include "precomp.h"
+#include <core/cell_text_cache.h>
+
+namespace pserv
+{
+    const std::string &CellTextCache::Get(const DataObject &dataObject, int column)
+    {
+        if (&dataObject != m_pLastObject)
+        {
+            m_pLastObject = &dataObject;
+            m_pLastRow = &m_rows[&dataObject];
+            m_pLastRow->LastUsedFrame = m_frame;
+        }
+
+        auto &cells = m_pLastRow->Cells;
+        if (static_cast<size_t>(column) >= cells.size())
+        {
+            cells.resize(static_cast<size_t>(column) + 1);
+        }
+        auto &cell = cells[static_cast<size_t>(column)];
+        const uint64_t serial = dataObject.GetModificationSerial();
+        if (cell.Serial != serial)
+        {
+            cell.Text = dataObject.GetProperty(column);
+            cell.Serial = serial;
+        }
+        return cell.Text;
+    }
+
+    void CellTextCache::EndFrame()
+    {
+        ++m_frame;
+        m_pLastObject = nullptr;
+        m_pLastRow = nullptr;
+        if (m_frame % EVICTION_FRAMES == 0)
+        {
+            std::erase_if(m_rows, [this](const auto &entry) { return entry.second.LastUsedFrame + EVICTION_FRAMES < m_frame; });
+        }
+    }
+
+    void CellTextCache::Clear() noexcept
+    {
+        m_rows.clear();
+        m_pLastObject = nullptr;
+        m_pLastRow = nullptr;
+    }
+} // namespace pserv
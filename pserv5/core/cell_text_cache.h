@@ -0,0 +1,61 @@
+/// @file cell_text_cache.h
+/// @brief Formatted cell texts of the rows on screen, kept between frames.
+///
+/// DataObject::GetProperty() formats a value into a new string each time
+/// (numbers, sizes, durations, file times with a time zone conversion). The
+/// table asks for every visible cell on every frame, although the values only
+/// change when a refresh modifies the object. The cache keeps the text of each
+/// cell together with the object's modification serial and formats it again
+/// only when the serial moved on, so an unchanged table renders without
+/// formatting or allocating.
+#pragma once
+
+#include <core/data_object.h>
+
+namespace pserv
+{
+    /// @brief Cache of DataObject::GetProperty() results, keyed by object, column and modification serial.
+    class CellTextCache final
+    {
+    public:
+        /// @brief Frames a row may go unused before its texts are dropped.
+        static constexpr uint64_t EVICTION_FRAMES = 120;
+
+        /// @brief Get the text of a cell, formatting it only if the object changed since the last call.
+        /// @return Valid until the next call of Get() for the same object, EndFrame() or Clear().
+        const std::string &Get(const DataObject &dataObject, int column);
+
+        /// @brief Advance the frame counter and drop rows that have not been shown for a while.
+        /// Call once per frame.
+        void EndFrame();
+
+        /// @brief Drop all cached texts.
+        void Clear() noexcept;
+
+        /// @brief Get the number of cached rows.
+        size_t GetSize() const noexcept
+        {
+            return m_rows.size();
+        }
+
+    private:
+        struct Cell final
+        {
+            uint64_t Serial{0}; ///< Modification serial the text was formatted at; 0 if never formatted.
+            std::string Text;
+        };
+
+        struct Row final
+        {
+            uint64_t LastUsedFrame{0};
+            std::vector<Cell> Cells;
+        };
+
+        // Keyed by address only: a new object at a recycled address has a newer modification
+        // serial than anything cached for the old one, so its cells are formatted again.
+        std::unordered_map<const DataObject *, Row> m_rows;
+        const DataObject *m_pLastObject{nullptr}; ///< Row of the previous Get(), so a row costs one lookup...
+        Row *m_pLastRow{nullptr};                 ///< ...instead of one per column.
+        uint64_t m_frame{0};
+    };
+} // namespace pserv
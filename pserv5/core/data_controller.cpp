@@ -13,11 +13,9 @@ namespace pserv
     DataController::~DataController()
     {
 #ifndef PSERV_CONSOLE_BUILD
-        if (m_pPropertiesDialog)
-        {
-            m_pPropertiesDialog->Close();
-            m_pPropertiesDialog = nullptr;
-        }
+        // The dialog retains its objects
+        delete m_pPropertiesDialog;
+        m_pPropertiesDialog = nullptr;
 #endif
         Clear();
     }
@@ -27,6 +25,7 @@ namespace pserv
     {
         if (!ctx.m_selectedObjects.empty())
         {
+            delete m_pPropertiesDialog;
             m_pPropertiesDialog = DBG_NEW DataPropertiesDialog{this, ctx.m_selectedObjects, ctx.m_hWnd};
             m_pPropertiesDialog->Open();
         }
@@ -60,14 +59,19 @@ namespace pserv
             .help("Filter results by text (case-insensitive substring match across all fields)")
             .default_value(std::string(""));
 
+        // Add query option (column predicates, see FilterQuery)
+        cmd.add_argument("--where")
+            .help("Filter results by query, e.g. \"User:SYSTEM WorkingSetSize>500MB Name~^svc\" (supports AND, OR, NOT)")
+            .default_value(std::string(""));
+
         // Add sort option
         cmd.add_argument("--sort")
-            .help("Sort by column name (ascending by default)")
+            .help("Sort by comma-separated column names, prefix '-' for descending (e.g. \"User,-Working Set\")")
             .default_value(std::string(""));
 
         // Add descending sort flag
         cmd.add_argument("--desc")
-            .help("Sort in descending order (use with --sort)")
+            .help("Reverse the sort order (use with --sort)")
             .default_value(false)
             .implicit_value(true);
 
@@ -142,14 +146,208 @@ namespace pserv
         if (columnIndex < 0 || columnIndex >= static_cast<int>(m_columns.size()))
             return;
 
-        // Remember last sort for re-applying after refresh
-        m_lastSortColumn = columnIndex;
-        m_lastSortAscending = ascending;
+        Sort(std::vector<SortSpec>{SortSpec{columnIndex, ascending}});
+    }
+
+    void DataController::Sort(const std::vector<SortSpec> &sortSpecs)
+    {
+        std::vector<SortSpec> validSpecs;
+        for (const auto &spec : sortSpecs)
+        {
+            if (spec.ColumnIndex >= 0 && spec.ColumnIndex < static_cast<int>(m_columns.size()))
+            {
+                validSpecs.push_back(spec);
+            }
+        }
+        if (validSpecs.empty())
+            return;
+
+        // Picked up by PublishSnapshot(), so the order survives refreshes
+        {
+            std::lock_guard<std::mutex> lock{m_sortMutex};
+            m_requestedSortSpecs = validSpecs;
+        }
 
-        ColumnDataType dataType = m_columns[columnIndex].DataType;
-        m_objects.Sort(columnIndex, ascending, dataType);
+        // Published snapshots are never modified: publish a sorted copy instead. If a
+        // background refresh published in the meantime, sort its snapshot instead.
+        auto current = m_snapshot.load(std::memory_order_acquire);
+        while (current->GetSortSpecs() != validSpecs)
+        {
+            auto sorted = std::make_shared<DataObjectContainer>(*current);
+            sorted->Sort(validSpecs, m_columns);
+            if (m_snapshot.compare_exchange_strong(current, sorted, std::memory_order_acq_rel, std::memory_order_acquire))
+                break;
+        }
+    }
+
+    std::vector<SortSpec> DataController::GetSortSpecs() const
+    {
+        std::lock_guard<std::mutex> lock{m_sortMutex};
+        return m_requestedSortSpecs;
+    }
+
+    bool DataController::RefreshInBackground()
+    {
+        if (m_bBackgroundRefreshRunning)
+            return false;
+
+        if (m_backgroundRefreshThread.joinable())
+        {
+            m_backgroundRefreshThread.join();
+        }
+        m_bBackgroundRefreshRunning = true;
+        m_backgroundRefreshThread = std::thread([this]() {
+            try
+            {
+                Refresh(true);
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Background refresh of {} failed: {}", m_controllerName, e.what());
+            }
+            m_bBackgroundRefreshRunning = false;
+        });
+        return true;
+    }
+
+    void DataController::WaitForBackgroundRefresh()
+    {
+        if (m_backgroundRefreshThread.joinable())
+        {
+            m_backgroundRefreshThread.join();
+        }
+    }
+
+    void DataController::StartRefresh()
+    {
+        if (m_retired)
+        {
+            // Update the objects of the previous snapshot in place, unless a reader still holds
+            // that snapshot or one of its objects (e.g. the UI selection). Otherwise start over
+            // with an empty working container; the retired one is freed by its last reader.
+            bool isUnused = m_retired.use_count() == 1;
+            // use_count() is a relaxed load. The fence makes the last reader's accesses (e.g. the
+            // background filter reading m_searchText) happen before we modify the objects; it pairs
+            // with the release in that reader's shared_ptr destructor. IsShared() loads with acquire.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            isUnused = isUnused &&
+                std::ranges::none_of(*m_retired, [](const DataObject *dataObject) { return dataObject->IsShared(); });
+            if (isUnused)
+            {
+                m_objects = std::move(*m_retired);
+            }
+            m_retired.reset();
+        }
+        if (m_bTextIndexEnabled)
+        {
+            // A recycled container brings its index along; a fresh one starts an empty index
+            m_bTextIndexBuilt = m_objects.GetTextIndex() == nullptr;
+            m_objects.EnableTextIndex();
+        }
+        m_objects.StartRefresh();
+    }
+
+    void DataController::SetLoaded()
+    {
+        PublishSnapshot();
+        m_lastRefreshTime = std::chrono::system_clock::now();
+        m_bLoaded = true;
+    }
+
+    void DataController::PublishSnapshot()
+    {
+        // Apply a sort order requested while this generation was being built
+        const auto sortSpecs = GetSortSpecs();
+        if (!sortSpecs.empty() && sortSpecs != m_objects.GetSortSpecs())
+        {
+            m_objects.Sort(sortSpecs, m_columns);
+        }
+
+        UpdateStatistics();
+
+        // Log the size of the text index when it was built or compacted, not on every publish:
+        // GetStatistics() walks all posting lists.
+        const auto *pTextIndex = m_objects.GetTextIndex();
+        if (pTextIndex && (m_bTextIndexBuilt || pTextIndex->GetCompactionCount() != m_loggedTextIndexCompactions) &&
+            spdlog::should_log(spdlog::level::debug))
+        {
+            m_bTextIndexBuilt = false;
+            m_loggedTextIndexCompactions = pTextIndex->GetCompactionCount();
+            const auto statistics = pTextIndex->GetStatistics();
+            spdlog::debug("{}: text index has {} objects, {} trigrams, {} postings, {} KB",
+                m_controllerName,
+                statistics.ObjectCount,
+                statistics.TrigramCount,
+                statistics.PostingCount,
+                statistics.MemoryBytes / 1024);
+        }
+
+        // Readers switch to the new generation with their next GetSnapshot(); the previous one
+        // is kept as a candidate for the working container of the next refresh.
+        auto published = std::make_shared<DataObjectContainer>(std::move(m_objects));
+        m_retired = m_snapshot.exchange(std::move(published), std::memory_order_acq_rel);
     }
     
+    void DataController::AddAggregate(std::string label, ColumnDataType dataType)
+    {
+        assert(m_aggregates.size() < DataObjectStatistics::MAX_AGGREGATES);
+        m_aggregates.push_back({std::move(label), dataType});
+    }
+
+    DataObjectStatistics::Values DataController::GetStatisticsValues(const DataObject *dataObject) const
+    {
+        DataObjectStatistics::Values values;
+        if (IsVisualStateKnown(dataObject))
+        {
+            const auto visualState = GetVisualState(dataObject);
+            values.HighlightedCount = visualState == VisualState::Highlighted ? 1 : 0;
+            values.DisabledCount = visualState == VisualState::Disabled ? 1 : 0;
+        }
+        else
+        {
+            values.PendingVisualStateCount = 1;
+        }
+        for (size_t index = 0; index < m_aggregates.size(); ++index)
+        {
+            values.Aggregates[index] = GetAggregateValue(dataObject, index);
+        }
+        return values;
+    }
+
+    void DataController::UpdateStatistics()
+    {
+        // Apply the last changeset if the statistics are exactly one refresh behind it: only
+        // objects whose values changed (SetRunning(), SetDisabled(), ...) are looked at again.
+        // Otherwise (new or cleared container, failed refresh, InvalidateStatistics()) recount.
+        const auto &changeset = m_objects.GetLastChangeset();
+        auto &statistics = m_objects.GetMutableStatistics();
+        const bool bFollowsOn = statistics.GetEpoch() == m_statisticsEpoch && statistics.GetGeneration() + 1 == changeset.Generation;
+        if (bFollowsOn)
+        {
+            for (const auto dataObject : changeset.Removed)
+            {
+                statistics.Erase(dataObject);
+            }
+            for (const auto dataObject : changeset.Added)
+            {
+                statistics.Update(dataObject, GetStatisticsValues(dataObject));
+            }
+            for (const auto dataObject : changeset.Modified)
+            {
+                statistics.Update(dataObject, GetStatisticsValues(dataObject));
+            }
+        }
+        if (!bFollowsOn || statistics.GetObjectCount() != m_objects.GetSize())
+        {
+            statistics.Clear();
+            for (const auto dataObject : m_objects)
+            {
+                statistics.Update(dataObject, GetStatisticsValues(dataObject));
+            }
+        }
+        statistics.SetBasis(changeset.Generation, m_statisticsEpoch);
+    }
+
 #ifndef PSERV_CONSOLE_BUILD
 
     bool DataController::HasPropertiesDialogWithEdits() const
@@ -166,6 +364,7 @@ namespace pserv
             if (changesApplied)
             {
                 // Refresh to show updated data
+                WaitForBackgroundRefresh();
                 Refresh();
             }
 
@@ -182,7 +381,10 @@ namespace pserv
 
     void DataController::Clear()
     {
+        WaitForBackgroundRefresh();
         m_objects.Clear();
+        m_retired.reset();
+        m_snapshot.store(std::make_shared<DataObjectContainer>(), std::memory_order_release);
         m_bLoaded = false;
     }
 
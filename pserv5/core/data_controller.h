@@ -3,6 +3,13 @@
 ///
 /// DataController is the central abstraction for managing a collection of
 /// DataObjects representing a specific system resource type (services, processes, etc.).
+///
+/// @par Snapshots:
+/// Refresh() builds the next generation of objects in a private working
+/// container and publishes it as an immutable snapshot with an atomic swap
+/// (see SetLoaded()). Readers such as the render loop call GetSnapshot() and
+/// never take a lock, so a refresh can run on a worker thread
+/// (RefreshInBackground()) while the previous snapshot is being displayed.
 #pragma once
 #include <core/data_object_column.h>
 #include <core/data_object_container.h>
@@ -76,7 +83,12 @@ namespace pserv
     ///         {"Value", "value", ColumnDataType::Integer}
     ///     }) {}
     ///
-    ///     void Refresh(bool isAutoRefresh) override { /* Load data */ }
+    ///     void Refresh(bool isAutoRefresh) override {
+    ///         StartRefresh();
+    ///         /* Add or update objects in m_objects */
+    ///         m_objects.FinishRefresh();
+    ///         SetLoaded(); // Publishes the snapshot
+    ///     }
     ///     VisualState GetVisualState(const DataObject*) const override {
     ///         return VisualState::Normal;
     ///     }
@@ -96,6 +108,7 @@ namespace pserv
             : m_controllerName{std::move(controllerName)}
             , m_itemName{std::move(itemName)}
             , m_columns{std::move(columns)}
+            , m_snapshot{std::make_shared<DataObjectContainer>()}
 #ifndef PSERV_CONSOLE_BUILD
             , m_pPropertiesDialog{nullptr}
 #endif
@@ -136,8 +149,46 @@ namespace pserv
         virtual std::vector<const DataAction *> GetAllActions() const { return {}; }
 #endif
 
-        /// @brief Get read-only access to the data container.
-        const DataObjectContainer &GetDataObjects() const { return m_objects; }
+        /// @brief Get the most recently published snapshot of the data objects.
+        /// Lock-free. The returned container is never modified once published and
+        /// stays valid for as long as the caller holds the pointer; never null.
+        std::shared_ptr<const DataObjectContainer> GetSnapshot() const
+        {
+            return m_snapshot.load(std::memory_order_acquire);
+        }
+
+        /// @name Background Refresh
+        /// @{
+
+        /// @brief Run Refresh(true) on a worker thread; the result is published as the next snapshot.
+        /// @return false if the previous background refresh is still running (nothing is started).
+        bool RefreshInBackground();
+
+        /// @brief Check if a refresh started by RefreshInBackground() is still running.
+        bool IsRefreshingInBackground() const { return m_bBackgroundRefreshRunning; }
+
+        /// @brief Block until the running background refresh (if any) has finished.
+        /// Refresh() implementations are not reentrant: call this before refreshing synchronously.
+        void WaitForBackgroundRefresh();
+        /// @}
+
+        /// @brief Tell the controller which objects the user looks at (on screen or selected).
+        /// Controllers with expensive fields load them for these objects only; call again when
+        /// the objects, the filter or the sort order changed.
+        /// @param stableKeys Keys of the objects on screen or selected.
+        /// @param bFiltered A filter is active, so the fields of all objects may be matched against.
+        /// @return true if some of these objects still lack such fields: a refresh would load them.
+        virtual bool SetObjectsOfInterest(std::vector<StableKey> stableKeys, bool bFiltered) { return false; }
+
+        /// @brief Check whether lazily loaded fields arrived in the background since the last
+        /// refresh started (e.g. account names); a refresh would show them.
+        virtual bool HasPendingLazyFields() const { return false; }
+
+        /// @brief Check whether GetVisualState() can already decide for an object.
+        /// False while a field it depends on is loaded lazily and has not arrived yet; the
+        /// status bar then leaves out the highlighted and disabled counts, see
+        /// DataObjectStatistics::HasVisualStateCounts().
+        virtual bool IsVisualStateKnown(const DataObject *dataObject) const { return true; }
 
         /// @brief Check if this controller supports auto-refresh.
         /// @return true if periodic refresh is meaningful for this data type.
@@ -157,6 +208,14 @@ namespace pserv
         /// @param ascending True for ascending, false for descending.
         void Sort(int columnIndex, bool ascending);
 
+        /// @brief Stable sort of objects by several columns.
+        /// Publishes a re-ordered copy of the current snapshot; later refreshes keep the order.
+        /// @param sortSpecs Sort keys in priority order; invalid column indices are dropped.
+        void Sort(const std::vector<SortSpec> &sortSpecs);
+
+        /// @brief Get the sort order requested by the last Sort() call (re-applied after refresh).
+        std::vector<SortSpec> GetSortSpecs() const;
+
         /// @name Property Editing Transaction
         /// Override these methods to support in-place editing in the properties dialog.
         /// @{
@@ -185,30 +244,75 @@ namespace pserv
         bool NeedsRefresh() const { return m_bNeedsRefresh; }
         void ClearRefreshFlag() { m_bNeedsRefresh = false; }
         std::chrono::system_clock::time_point GetLastRefreshTime() const { return m_lastRefreshTime; }
+        const std::vector<DataObjectAggregate> &GetAggregates() const { return m_aggregates; }
         /// @}
 
     protected:
         /// @brief Clear all data objects from the container.
         void Clear();
 
-        /// @brief Mark the controller as loaded and record the refresh timestamp.
-        /// Call this at the end of a successful Refresh() implementation.
-        void SetLoaded()
+        /// @brief Begin a refresh cycle on the working container.
+        /// Recycles the container retired by the previous publish (so unchanged objects are
+        /// updated in place) once nobody references it any more, then calls m_objects.StartRefresh().
+        void StartRefresh();
+
+        /// @brief Maintain a trigram index over the search text of the objects (see
+        /// DataObjectContainer::EnableTextIndex()), which speeds up filtering large views.
+        /// Call from the constructor of controllers with many rows.
+        void EnableTextIndex() noexcept
         {
-            m_bLoaded = true;
-            m_lastRefreshTime = std::chrono::system_clock::now();
+            m_bTextIndexEnabled = true;
         }
 
+        /// @brief Show a sum over all objects in the status bar, e.g. the total working set.
+        /// Call from the constructor, at most DataObjectStatistics::MAX_AGGREGATES times.
+        void AddAggregate(std::string label, ColumnDataType dataType);
+
+        /// @brief Get what an object contributes to an aggregate added with AddAggregate().
+        /// Called when the object was added or modified by a refresh.
+        virtual uint64_t GetAggregateValue(const DataObject *dataObject, size_t aggregateIndex) const
+        {
+            return 0;
+        }
+
+        /// @brief Recount the statistics of all objects when the next snapshot is published.
+        /// Call when something GetVisualState() depends on changed outside the objects.
+        void InvalidateStatistics() noexcept
+        {
+            ++m_statisticsEpoch;
+        }
+
+        /// @brief Mark the controller as loaded, record the refresh timestamp and publish
+        /// m_objects as the new snapshot.
+        /// Call this at the end of a successful Refresh() implementation. Afterwards m_objects
+        /// is an empty working container again; do not keep pointers into it.
+        void SetLoaded();
+
     protected:
         const std::string m_controllerName;              ///< Controller identifier.
         const std::string m_itemName;                    ///< Singular item name for UI.
         const std::vector<DataObjectColumn> m_columns;   ///< Column definitions.
-        DataObjectContainer m_objects;                   ///< Data storage.
-        int m_lastSortColumn{-1};                        ///< Last sorted column index.
-        bool m_bLoaded{false};                           ///< True after first successful load.
+        DataObjectContainer m_objects;                   ///< Working container filled by Refresh(); not visible to readers.
+        std::atomic<bool> m_bLoaded{false};              ///< True after first successful load.
         bool m_bNeedsRefresh{false};                     ///< True if data needs reloading.
-        bool m_lastSortAscending{true};                  ///< Last sort direction.
-        std::chrono::system_clock::time_point m_lastRefreshTime{}; ///< Time of last successful refresh.
+        std::atomic<std::chrono::system_clock::time_point> m_lastRefreshTime{}; ///< Time of last successful refresh.
+
+    private:
+        void PublishSnapshot();
+        void UpdateStatistics();
+        DataObjectStatistics::Values GetStatisticsValues(const DataObject *dataObject) const;
+
+        std::atomic<std::shared_ptr<DataObjectContainer>> m_snapshot; ///< Published, immutable snapshot.
+        std::shared_ptr<DataObjectContainer> m_retired;               ///< Previous snapshot, candidate for the next m_objects.
+        mutable std::mutex m_sortMutex;                               ///< Guards m_requestedSortSpecs.
+        std::vector<SortSpec> m_requestedSortSpecs;                   ///< Order requested by Sort(), applied on publish.
+        std::thread m_backgroundRefreshThread;                        ///< Worker of RefreshInBackground().
+        std::atomic<bool> m_bBackgroundRefreshRunning{false};         ///< True while the worker runs.
+        bool m_bTextIndexEnabled{false};                              ///< See EnableTextIndex().
+        bool m_bTextIndexBuilt{false};                                ///< The working container started a new text index.
+        uint64_t m_loggedTextIndexCompactions{0};                     ///< Compaction count when the index was last logged.
+        std::vector<DataObjectAggregate> m_aggregates;                ///< See AddAggregate().
+        uint64_t m_statisticsEpoch{0};                                ///< See InvalidateStatistics().
 
 #ifndef PSERV_CONSOLE_BUILD
     private:
@@ -28,6 +28,11 @@ namespace pserv
 
     void DataControllerLibrary::Clear()
     {
+        // Background refreshes call back into the controllers, so let them finish first
+        for (const auto ptr : dataControllers)
+        {
+            ptr->WaitForBackgroundRefresh();
+        }
         for (const auto ptr : dataControllers)
         {
             delete ptr;
@@ -6,6 +6,9 @@
 /// a specific type of system object.
 #pragma once
 #include <core/refcount_interface.h>
+#include <core/secondary_index.h>
+#include <core/stable_key.h>
+#include <utils/text_search.h>
 
 namespace pserv
 {
@@ -26,16 +29,90 @@ namespace pserv
     {
     private:
         friend class DataObjectContainer;
-        uint64_t m_LastSeenGeneration{0}; ///< Used for stale object detection during refresh.
-        bool m_bIsRunning{false};         ///< Visual state hint: item is active/running.
-        bool m_bIsDisabled{false};        ///< Visual state hint: item is disabled/inactive.
+        uint64_t m_LastSeenGeneration{0};                             ///< Used for stale object detection during refresh.
+        uint64_t m_ModificationSerial{NextModificationSerial()};      ///< Serial of the last actual value change.
+        bool m_bIsRunning{false};                                     ///< Visual state hint: item is active/running.
+        bool m_bIsDisabled{false};                                    ///< Visual state hint: item is disabled/inactive.
+        mutable bool m_bSearchTextValid{false};                       ///< False until built and after a searchable field changed.
+        mutable std::string m_searchText;                             ///< Case-folded searchable fields, see GetSearchText().
+
+        /// @brief Process-wide modification counter shared by all DataObjects.
+        static std::atomic<uint64_t> &ModificationSerialCounter() noexcept
+        {
+            static std::atomic<uint64_t> counter{0};
+            return counter;
+        }
+
+        static uint64_t NextModificationSerial() noexcept
+        {
+            return ModificationSerialCounter().fetch_add(1, std::memory_order_relaxed) + 1;
+        }
 
     protected:
         /// @brief Set the running state (affects visual highlighting).
-        void SetRunning(bool bRunning) { m_bIsRunning = bRunning; }
+        void SetRunning(bool bRunning) { UpdateValue(m_bIsRunning, bRunning); }
 
         /// @brief Set the disabled state (affects visual graying).
-        void SetDisabled(bool bDisabled) { m_bIsDisabled = bDisabled; }
+        void SetDisabled(bool bDisabled) { UpdateValue(m_bIsDisabled, bDisabled); }
+
+        /// @brief Record that a displayed value of this object has changed.
+        void MarkModified() noexcept { m_ModificationSerial = NextModificationSerial(); }
+
+        /// @brief Assign a field and mark the object modified, but only if the value differs.
+        /// @return true if the field was changed.
+        /// @note Model setters should go through this so refresh changesets only report real changes.
+        template <typename T, typename V> bool UpdateValue(T &field, V &&value)
+        {
+            if (field == value)
+                return false;
+            field = std::forward<V>(value);
+            MarkModified();
+            return true;
+        }
+
+        bool UpdateValue(FILETIME &field, const FILETIME &value) noexcept
+        {
+            if (field.dwLowDateTime == value.dwLowDateTime && field.dwHighDateTime == value.dwHighDateTime)
+                return false;
+            field = value;
+            MarkModified();
+            return true;
+        }
+
+        bool UpdateValue(RECT &field, const RECT &value) noexcept
+        {
+            if (field.left == value.left && field.top == value.top && field.right == value.right && field.bottom == value.bottom)
+                return false;
+            field = value;
+            MarkModified();
+            return true;
+        }
+
+        /// @brief UpdateValue() for a field that is part of the search text (see BuildSearchText()).
+        /// @return true if the field was changed (and the cached search text dropped).
+        template <typename T, typename V> bool UpdateSearchableValue(T &field, V &&value)
+        {
+            if (!UpdateValue(field, std::forward<V>(value)))
+                return false;
+            InvalidateSearchText();
+            return true;
+        }
+
+        /// @brief Drop the cached search text; it is rebuilt by the next GetSearchText().
+        void InvalidateSearchText() noexcept { m_bSearchTextValid = false; }
+
+        /// @brief Append the text of every searchable field to @p text, using AppendSearchField().
+        /// Called lazily by GetSearchText(); the result is case-folded there.
+        /// @note Every field used here must be set through UpdateSearchableValue() (or only in the constructor).
+        virtual void BuildSearchText(std::string &text) const = 0;
+
+        /// @brief Append one field to the search text. Fields are separated by '\n',
+        /// so a filter never matches across two fields.
+        static void AppendSearchField(std::string &text, std::string_view field)
+        {
+            text.append(field);
+            text.push_back('\n');
+        }
 
     public:
         virtual ~DataObject() = default;
@@ -51,10 +128,47 @@ namespace pserv
         virtual PropertyValue GetTypedProperty(int propertyId) const = 0;
 
         /// @brief Test if this object matches a filter string.
-        /// @param filter Lowercase filter text to match against.
-        /// @return true if any property contains the filter text.
-        /// @note The filter is pre-lowercased by the caller for performance.
-        virtual bool MatchesFilter(const std::string &filter) const = 0;
+        /// @param filter Filter text to match against, in any case.
+        /// @return true if any searchable field contains the filter text (case-insensitive).
+        /// @note Matching is a single utils::FindIgnoreCase() scan over the cached search text
+        ///       and does not allocate.
+        bool MatchesFilter(std::string_view filter) const
+        {
+            return filter.empty() || utils::ContainsIgnoreCase(GetSearchText(), filter);
+        }
+
+        /// @brief Get the case-folded (ASCII lowercase) text of all searchable fields, '\n'-separated.
+        /// Built on first use and cached until a searchable field changes.
+        /// @note Not synchronized: like the setters, call it from one thread at a time per object.
+        const std::string &GetSearchText() const
+        {
+            if (!m_bSearchTextValid)
+            {
+                m_searchText.clear();
+                BuildSearchText(m_searchText);
+                for (char &c : m_searchText)
+                {
+                    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                }
+                m_bSearchTextValid = true;
+            }
+            return m_searchText;
+        }
+
+        /// @brief Get the compact binary identity of this object.
+        /// @return Key composed from the model's native identity fields.
+        /// @note Must identify the same object as GetStableID(); used for container lookups.
+        virtual StableKey GetStableKey() const = 0;
+
+        /// @brief Get the key this object is filed under in a secondary index of its container.
+        /// @param index The secondary index.
+        /// @return The key (see SecondaryKey), or std::nullopt if the object is not part of that index.
+        /// @note Re-evaluated on DataObjectContainer::Append() and for added and modified objects
+        ///       in FinishRefresh(), so the key must only depend on values set through UpdateValue().
+        virtual std::optional<StableKey> GetSecondaryKey(SecondaryIndex index) const
+        {
+            return std::nullopt;
+        }
 
         /// @brief Get a human-readable name for this item.
         /// @return Display name (e.g., service name, process name).
@@ -65,5 +179,16 @@ namespace pserv
 
         /// @brief Check if this item is disabled.
         bool IsDisabled() const { return m_bIsDisabled; }
+
+        /// @brief Get the serial of the last actual value change.
+        /// @note Serials come from one process-wide counter, so they are unique across
+        ///       containers and grow monotonically; compare against GetCurrentModificationSerial().
+        uint64_t GetModificationSerial() const { return m_ModificationSerial; }
+
+        /// @brief Get the most recently issued modification serial.
+        static uint64_t GetCurrentModificationSerial() noexcept
+        {
+            return ModificationSerialCounter().load(std::memory_order_relaxed);
+        }
     };
 } // namespace pserv
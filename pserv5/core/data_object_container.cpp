@@ -2,97 +2,294 @@
 #include <core/refcount_interface.h>
 #include <core/data_object.h>
 #include <core/data_object_container.h>
-#include <utils/string_utils.h>
 
 
 namespace pserv
 {
     DataObjectContainer::~DataObjectContainer()
     {
+        m_pTextIndex.reset();
         Clear();
     }
 
+    /// Compare an object against a precomputed composite key, honouring each key's direction.
+    /// Keys of the object are extracted lazily, so a difference in the first column costs one extraction.
+    static int CompareWithKeys(
+        const DataObject *dataObject, const SortKey *keys, const std::vector<SortSpec> &sortSpecs, const std::vector<ColumnDataType> &dataTypes)
+    {
+        for (size_t i = 0; i < sortSpecs.size(); ++i)
+        {
+            const int cmp = SortKey::Create(*dataObject, sortSpecs[i].ColumnIndex, dataTypes[i]).Compare(keys[i]);
+            if (cmp != 0)
+                return sortSpecs[i].Ascending ? cmp : -cmp;
+        }
+        return 0;
+    }
+
+    static void CreateKeys(
+        const DataObject *dataObject, const std::vector<SortSpec> &sortSpecs, const std::vector<ColumnDataType> &dataTypes, std::vector<SortKey> &keys)
+    {
+        keys.clear();
+        for (size_t i = 0; i < sortSpecs.size(); ++i)
+        {
+            keys.push_back(SortKey::Create(*dataObject, sortSpecs[i].ColumnIndex, dataTypes[i]));
+        }
+    }
+
     void DataObjectContainer::Sort(int columnIndex, bool ascending, ColumnDataType dataType)
     {
-        std::sort(m_vector.begin(),
-            m_vector.end(),
-            [columnIndex, ascending, dataType](const DataObject *a, const DataObject *b)
+        SortWith({SortSpec{columnIndex, ascending}}, {dataType});
+    }
+
+    void DataObjectContainer::Sort(const std::vector<SortSpec> &sortSpecs, const std::vector<DataObjectColumn> &columns)
+    {
+        std::vector<SortSpec> validSpecs;
+        std::vector<ColumnDataType> dataTypes;
+        for (const auto &spec : sortSpecs)
+        {
+            if (spec.ColumnIndex >= 0 && spec.ColumnIndex < static_cast<int>(columns.size()))
             {
-                PropertyValue valA = a->GetTypedProperty(columnIndex);
-                PropertyValue valB = b->GetTypedProperty(columnIndex);
+                validSpecs.push_back(spec);
+                dataTypes.push_back(columns[spec.ColumnIndex].DataType);
+            }
+        }
+        SortWith(std::move(validSpecs), std::move(dataTypes));
+    }
 
-                // Numeric comparison for Integer, UnsignedInteger, and Size types
-                if (dataType == ColumnDataType::Integer || dataType == ColumnDataType::UnsignedInteger || dataType == ColumnDataType::Size)
-                {
+    void DataObjectContainer::SortWith(std::vector<SortSpec> sortSpecs, std::vector<ColumnDataType> dataTypes)
+    {
+        m_sortOrder.Specs = std::move(sortSpecs);
+        m_sortOrder.DataTypes = std::move(dataTypes);
+        m_sortOrder.SortedSerial = DataObject::GetCurrentModificationSerial();
+        m_sortOrder.bFullSortNeeded = false;
+        SortRows(m_vector, m_sortOrder.Specs, m_sortOrder.DataTypes);
+    }
 
-                    uint64_t numA = 0, numB = 0;
+    bool DataObjectContainer::Resort()
+    {
+        if (m_sortOrder.Specs.empty())
+            return false;
 
-                    if (std::holds_alternative<uint64_t>(valA))
-                    {
-                        numA = std::get<uint64_t>(valA);
-                    }
-                    else if (std::holds_alternative<int64_t>(valA))
-                    {
-                        numA = static_cast<uint64_t>(std::get<int64_t>(valA));
-                    }
+        bool bChanged = true;
+        if (m_sortOrder.bFullSortNeeded)
+        {
+            SortRows(m_vector, m_sortOrder.Specs, m_sortOrder.DataTypes);
+        }
+        else
+        {
+            bChanged = ResortChanged();
+        }
+        m_sortOrder.SortedSerial = DataObject::GetCurrentModificationSerial();
+        m_sortOrder.bFullSortNeeded = false;
+        return bChanged;
+    }
 
-                    if (std::holds_alternative<uint64_t>(valB))
-                    {
-                        numB = std::get<uint64_t>(valB);
-                    }
-                    else if (std::holds_alternative<int64_t>(valB))
-                    {
-                        numB = static_cast<uint64_t>(std::get<int64_t>(valB));
-                    }
+    bool DataObjectContainer::ResortChanged()
+    {
+        const auto &sortSpecs = m_sortOrder.Specs;
+        const auto &dataTypes = m_sortOrder.DataTypes;
+        const uint64_t sortedSerial = m_sortOrder.SortedSerial;
 
-                    return ascending ? (numA < numB) : (numA > numB);
-                }
+        // Objects not changed since the last sort are still in order relative to each other
+        // (removals don't reorder), so the vector is sorted iff every changed object is in
+        // order with its direct neighbours.
+        std::vector<size_t> changedIndices;
+        for (size_t index = 0; index < m_vector.size(); ++index)
+        {
+            if (m_vector[index]->m_ModificationSerial > sortedSerial)
+            {
+                changedIndices.push_back(index);
+            }
+        }
+        if (changedIndices.empty())
+            return false;
 
-                // String comparison for String and Time types
-                std::string strA, strB;
+        std::vector<SortKey> keys;
+        const bool bInOrder = std::ranges::all_of(changedIndices,
+            [&](size_t index)
+            {
+                CreateKeys(m_vector[index], sortSpecs, dataTypes, keys);
+                if (index > 0 && CompareWithKeys(m_vector[index - 1], keys.data(), sortSpecs, dataTypes) > 0)
+                    return false;
+                if (index + 1 < m_vector.size() && CompareWithKeys(m_vector[index + 1], keys.data(), sortSpecs, dataTypes) < 0)
+                    return false;
+                return true;
+            });
+        if (bInOrder)
+            return false;
 
-                if (std::holds_alternative<std::string>(valA))
-                {
-                    strA = std::get<std::string>(valA);
-                }
-                else
-                {
-                    strA = a->GetProperty(columnIndex);
-                }
+        // With most objects changed, merging would not beat sorting everything
+        if (changedIndices.size() * 4 > m_vector.size())
+        {
+            SortRows(m_vector, sortSpecs, dataTypes);
+            return true;
+        }
 
-                if (std::holds_alternative<std::string>(valB))
-                {
-                    strB = std::get<std::string>(valB);
-                }
-                else
-                {
-                    strB = b->GetProperty(columnIndex);
-                }
+        // Split into the (still sorted) unchanged objects and the changed ones
+        std::vector<DataObject *> unchanged;
+        std::vector<DataObject *> changed;
+        unchanged.reserve(m_vector.size() - changedIndices.size());
+        changed.reserve(changedIndices.size());
+        for (const auto dataObject : m_vector)
+        {
+            (dataObject->m_ModificationSerial > sortedSerial ? changed : unchanged).push_back(dataObject);
+        }
+        SortRows(changed, sortSpecs, dataTypes);
+
+        // Merge: binary-search each changed object's place among the unchanged ones,
+        // extracting keys only for the probed objects (O(changed * log n) extractions).
+        std::vector<DataObject *> merged;
+        merged.reserve(m_vector.size());
+        auto unchangedIt = unchanged.begin();
+        for (const auto dataObject : changed)
+        {
+            CreateKeys(dataObject, sortSpecs, dataTypes, keys);
+            const auto insertIt = std::partition_point(unchangedIt,
+                unchanged.end(),
+                [&](const DataObject *other) { return CompareWithKeys(other, keys.data(), sortSpecs, dataTypes) <= 0; });
+            merged.insert(merged.end(), unchangedIt, insertIt);
+            merged.push_back(dataObject);
+            unchangedIt = insertIt;
+        }
+        merged.insert(merged.end(), unchangedIt, unchanged.end());
+        m_vector.swap(merged);
+        return true;
+    }
+
+    /// Rows below which SortRows() never goes parallel, see SetParallelSortThreshold().
+    static std::atomic<size_t> g_parallelSortThreshold{DataObjectContainer::DEFAULT_PARALLEL_SORT_THRESHOLD};
+
+    /// Minimum number of rows handled by one sort worker. parallel_sort_bench finds starting a
+    /// worker costs under 1% of sorting its chunk from about 3000 rows on; rounded up.
+    static constexpr size_t MIN_ROWS_PER_SORT_CHUNK = 4096;
+
+    /// Upper bound for sort workers, independent of the core count.
+    static constexpr size_t MAX_SORT_CHUNKS = 16;
+
+    /// Run fn(chunkIndex) for chunkCount chunks, one thread per chunk (the last chunk runs on the calling thread).
+    template <typename F> static void RunChunks(size_t chunkCount, const F &fn)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(chunkCount - 1);
+        for (size_t chunk = 0; chunk + 1 < chunkCount; ++chunk)
+        {
+            workers.emplace_back(fn, chunk);
+        }
+        fn(chunkCount - 1);
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
 
-                // Case-insensitive comparison using Windows CompareStringEx
-                // This handles Unicode properly and is locale-aware
-                // Convert UTF-8 strings to wide strings first
-                std::wstring wideA = utils::Utf8ToWide(strA);
-                std::wstring wideB = utils::Utf8ToWide(strB);
-
-                int cmp = CompareStringEx(
-                    LOCALE_NAME_USER_DEFAULT,
-                    LINGUISTIC_IGNORECASE,
-                    wideA.c_str(), static_cast<int>(wideA.length()),
-                    wideB.c_str(), static_cast<int>(wideB.length()),
-                    nullptr, nullptr, 0);
-
-                // CompareStringEx returns: 1 (less), 2 (equal), 3 (greater), or 0 (error)
-                if (cmp == 0)
+    void DataObjectContainer::SetParallelSortThreshold(size_t rowCount) noexcept
+    {
+        g_parallelSortThreshold = rowCount;
+    }
+
+    size_t DataObjectContainer::GetParallelSortThreshold() noexcept
+    {
+        return g_parallelSortThreshold;
+    }
+
+    size_t DataObjectContainer::GetSortChunkCount(size_t rowCount, unsigned hardwareThreads) noexcept
+    {
+        // With one core the chunks would run one after another and only add the merge passes
+        if (hardwareThreads <= 1)
+            return 1;
+
+        return std::max<size_t>(std::min({static_cast<size_t>(hardwareThreads), rowCount / MIN_ROWS_PER_SORT_CHUNK, MAX_SORT_CHUNKS}), 1);
+    }
+
+    void DataObjectContainer::SortRows(
+        std::vector<DataObject *> &rows, const std::vector<SortSpec> &sortSpecs, const std::vector<ColumnDataType> &dataTypes)
+    {
+        const size_t keyCount = sortSpecs.size();
+        const size_t rowCount = rows.size();
+        if (keyCount == 0 || rowCount < 2)
+            return;
+
+        // Split large sorts across cores: every worker extracts the keys of and sorts one
+        // contiguous chunk, then the sorted chunks are merged pairwise (also in parallel).
+        const size_t threshold = g_parallelSortThreshold;
+        size_t chunkCount = 1;
+        if (threshold > 0 && rowCount >= threshold)
+        {
+            chunkCount = GetSortChunkCount(rowCount, std::thread::hardware_concurrency());
+        }
+        const auto chunkBegin = [rowCount, chunkCount](size_t chunk) { return rowCount * chunk / chunkCount; };
+
+        // Extract every object's composite key once: row r owns keys[r * keyCount .. r * keyCount + keyCount).
+        // The comparator then only compares integers or memcmp's collation keys and never allocates.
+        std::vector<SortKey> keys(rowCount * keyCount);
+        std::vector<uint32_t> order(rowCount);
+        std::iota(order.begin(), order.end(), 0u);
+
+        // Ties fall back to the current position, which makes the order stable without
+        // std::stable_sort and makes the result independent of the chunking.
+        const auto isLess = [&keys, &sortSpecs, keyCount](uint32_t a, uint32_t b)
+        {
+            const SortKey *keyA = &keys[a * keyCount];
+            const SortKey *keyB = &keys[b * keyCount];
+            for (size_t i = 0; i < keyCount; ++i)
+            {
+                const int cmp = keyA[i].Compare(keyB[i]);
+                if (cmp != 0)
+                    return sortSpecs[i].Ascending ? (cmp < 0) : (cmp > 0);
+            }
+            return a < b;
+        };
+
+        const auto sortChunk = [&](size_t chunk)
+        {
+            const size_t begin = chunkBegin(chunk);
+            const size_t end = chunkBegin(chunk + 1);
+            for (size_t row = begin; row < end; ++row)
+            {
+                for (size_t i = 0; i < keyCount; ++i)
                 {
-                    // Error case - fall back to simple comparison
-                    cmp = strA.compare(strB);
-                    return ascending ? (cmp < 0) : (cmp > 0);
+                    keys[row * keyCount + i] = SortKey::Create(*rows[row], sortSpecs[i].ColumnIndex, dataTypes[i]);
                 }
+            }
+            std::sort(order.begin() + begin, order.begin() + end, isLess);
+        };
 
-                // Convert CompareStringEx result (1/2/3) to comparison result
-                return ascending ? (cmp == 1) : (cmp == 3);
-            });
+        if (chunkCount == 1)
+        {
+            sortChunk(0);
+        }
+        else
+        {
+            RunChunks(chunkCount, sortChunk);
+
+            // Merge neighbouring sorted runs until one run is left: run widths 1, 2, 4, ... chunks
+            for (size_t width = 1; width < chunkCount; width *= 2)
+            {
+                const size_t mergeCount = (chunkCount + 2 * width - 1) / (2 * width);
+                RunChunks(mergeCount,
+                    [&](size_t merge)
+                    {
+                        const size_t first = merge * 2 * width;
+                        const size_t middle = std::min(first + width, chunkCount);
+                        const size_t last = std::min(first + 2 * width, chunkCount);
+                        if (middle < last)
+                        {
+                            std::inplace_merge(order.begin() + chunkBegin(first),
+                                order.begin() + chunkBegin(middle),
+                                order.begin() + chunkBegin(last),
+                                isLess);
+                        }
+                    });
+            }
+        }
+
+        std::vector<DataObject *> sorted;
+        sorted.reserve(rowCount);
+        for (const auto index : order)
+        {
+            sorted.push_back(rows[index]);
+        }
+        rows.swap(sorted);
     }
 
     void DataObjectContainer::StartRefresh() noexcept
@@ -102,42 +299,184 @@ namespace pserv
             dataObject->m_LastSeenGeneration = m_LastSeenGeneration;
         }
         InterlockedIncrement(&m_LastSeenGeneration);
+
+        ReleaseChangeset();
+        m_refreshStartSerial = DataObject::GetCurrentModificationSerial();
+        m_refreshStartSize = m_vector.size();
     }
 
-    void DataObjectContainer::FinishRefresh()
+    const std::vector<StableKey> &DataObjectContainer::FinishRefresh()
     {
-        bool repeat = true;
-        while (repeat)
+        m_removedStableKeys.clear();
+        ReleaseChangeset();
+        m_changeset.Generation = m_LastSeenGeneration;
+
+        // Single compaction pass: surviving objects are moved down over the stale ones,
+        // so the relative order (and therefore any previous sort) is preserved.
+        // Objects at or beyond m_refreshStartSize were appended during this cycle.
+        const auto firstAdded = m_vector.begin() + std::min(m_refreshStartSize, m_vector.size());
+        auto writeIt = m_vector.begin();
+        for (auto readIt = m_vector.begin(); readIt != m_vector.end(); ++readIt)
         {
-            repeat = false;
-            uint32_t index = 0;
-            for (auto dataObject : m_vector)
+            const auto dataObject = *readIt;
+            if (dataObject->m_LastSeenGeneration != m_LastSeenGeneration)
             {
-                if (dataObject->m_LastSeenGeneration != m_LastSeenGeneration)
+                // Not seen in this generation, remove it; the changeset keeps our reference
+                const auto stableKey{dataObject->GetStableKey()};
+                m_lookup.Erase(stableKey);
+                UnindexObject(dataObject);
+                m_removedStableKeys.push_back(stableKey);
+                m_changeset.Removed.push_back(dataObject);
+            }
+            else
+            {
+                if (readIt >= firstAdded)
+                {
+                    m_changeset.Added.push_back(dataObject);
+                }
+                else if (dataObject->m_ModificationSerial > m_refreshStartSerial)
                 {
-                    // Not seen in this generation, remove it
-                    const auto stableId{dataObject->GetStableID()};
-                    m_lookup.erase(stableId);
-                    m_vector.erase(m_vector.begin() + index);
-                    dataObject->Release(REFCOUNT_DEBUG_ARGS);
-                    repeat = true;
-                    break;
+                    m_changeset.Modified.push_back(dataObject);
                 }
-                ++index;
+                *writeIt++ = dataObject;
             }
         }
+        m_vector.erase(writeIt, m_vector.end());
+        m_refreshStartSize = m_vector.size();
+
+        // Secondary keys may have been set or changed after Append()
+        for (const auto dataObject : m_changeset.Added)
+        {
+            IndexObject(dataObject);
+        }
+        for (const auto dataObject : m_changeset.Modified)
+        {
+            IndexObject(dataObject);
+        }
+
+        // Done after the secondary keys for the same reason: the search text is complete by now
+        if (m_pTextIndex && !m_changeset.IsEmpty())
+        {
+            auto &textIndex = GetMutableTextIndex();
+            for (const auto dataObject : m_changeset.Removed)
+            {
+                textIndex.Erase(dataObject);
+            }
+            for (const auto dataObject : m_changeset.Added)
+            {
+                textIndex.Update(dataObject);
+            }
+            for (const auto dataObject : m_changeset.Modified)
+            {
+                textIndex.Update(dataObject);
+            }
+        }
+        return m_removedStableKeys;
+    }
+
+    void DataObjectContainer::EnableTextIndex()
+    {
+        if (m_pTextIndex)
+            return;
+
+        m_pTextIndex = std::make_shared<TrigramIndex>();
+        for (const auto dataObject : m_vector)
+        {
+            m_pTextIndex->Update(dataObject);
+        }
+    }
+
+    TrigramIndex &DataObjectContainer::GetMutableTextIndex()
+    {
+        // Copy on write: a published snapshot sharing the index may still be queried
+        if (m_pTextIndex.use_count() > 1)
+        {
+            m_pTextIndex = std::make_shared<TrigramIndex>(*m_pTextIndex);
+        }
+        return *m_pTextIndex;
+    }
+
+    const DataObjectStatistics &DataObjectContainer::GetStatistics() const noexcept
+    {
+        static const DataObjectStatistics empty;
+        return m_pStatistics ? *m_pStatistics : empty;
+    }
+
+    DataObjectStatistics &DataObjectContainer::GetMutableStatistics()
+    {
+        if (!m_pStatistics)
+        {
+            m_pStatistics = std::make_shared<DataObjectStatistics>();
+        }
+        else if (m_pStatistics.use_count() > 1)
+        {
+            // Copy on write, like the text index
+            m_pStatistics = std::make_shared<DataObjectStatistics>(*m_pStatistics);
+        }
+        return *m_pStatistics;
+    }
+
+    bool DataObjectContainer::FindTextCandidates(std::span<const std::string_view> needles, std::vector<DataObject *> &candidates) const
+    {
+        // Objects appended since the last FinishRefresh() are not indexed yet
+        if (!m_pTextIndex || m_pTextIndex->GetObjectCount() != m_vector.size())
+            return false;
+        return m_pTextIndex->FindCandidates(needles, m_vector, candidates);
+    }
+
+    void DataObjectContainer::IndexObject(DataObject *dataObject)
+    {
+        for (size_t index = 0; index < m_secondaryIndexes.size(); ++index)
+        {
+            m_secondaryIndexes[index].Update(dataObject, dataObject->GetSecondaryKey(static_cast<SecondaryIndex>(index)));
+        }
+    }
+
+    void DataObjectContainer::UnindexObject(DataObject *dataObject)
+    {
+        for (auto &secondaryIndex : m_secondaryIndexes)
+        {
+            secondaryIndex.Erase(dataObject);
+        }
+    }
+
+    void DataObjectContainer::ReleaseChangeset() noexcept
+    {
+        for (const auto dataObject : m_changeset.Removed)
+        {
+            dataObject->Release(REFCOUNT_DEBUG_ARGS);
+        }
+        m_changeset = DataObjectChangeset{};
+    }
+
+    void DataObjectContainer::RetainChangeset() const noexcept
+    {
+        for (const auto dataObject : m_changeset.Removed)
+        {
+            dataObject->Retain(REFCOUNT_DEBUG_ARGS);
+        }
     }
 
     DataObjectContainer::DataObjectContainer(const DataObjectContainer& copySrc)
     {
         // Copy constructor
-        for (const auto& [key, dataObject] : copySrc.m_lookup)
+        for (const auto dataObject : copySrc.m_vector)
         {
             assert(dataObject != nullptr);
             dataObject->Retain(REFCOUNT_DEBUG_ARGS);
-            m_lookup[key] = dataObject;
         }
+        m_lookup = copySrc.m_lookup;
         m_vector = copySrc.m_vector;
+        m_removedStableKeys = copySrc.m_removedStableKeys;
+        m_changeset = copySrc.m_changeset;
+        m_secondaryIndexes = copySrc.m_secondaryIndexes;
+        m_LastSeenGeneration = copySrc.m_LastSeenGeneration;
+        m_refreshStartSerial = copySrc.m_refreshStartSerial;
+        m_refreshStartSize = copySrc.m_refreshStartSize;
+        m_sortOrder = copySrc.m_sortOrder;
+        m_pTextIndex = copySrc.m_pTextIndex;
+        m_pStatistics = copySrc.m_pStatistics;
+        RetainChangeset();
     }
 
     DataObjectContainer& DataObjectContainer::operator=(const DataObjectContainer& copySrc)
@@ -145,13 +484,23 @@ namespace pserv
         if (this != &copySrc)
         {
             Clear();
-            for (const auto& [key, dataObject] : copySrc.m_lookup)
+            for (const auto dataObject : copySrc.m_vector)
             {
                 assert(dataObject != nullptr);
                 dataObject->Retain(REFCOUNT_DEBUG_ARGS);
-                m_lookup[key] = dataObject;
             }
+            m_lookup = copySrc.m_lookup;
             m_vector = copySrc.m_vector;
+            m_removedStableKeys = copySrc.m_removedStableKeys;
+            m_changeset = copySrc.m_changeset;
+            m_secondaryIndexes = copySrc.m_secondaryIndexes;
+            m_LastSeenGeneration = copySrc.m_LastSeenGeneration;
+            m_refreshStartSerial = copySrc.m_refreshStartSerial;
+            m_refreshStartSize = copySrc.m_refreshStartSize;
+            m_sortOrder = copySrc.m_sortOrder;
+            m_pTextIndex = copySrc.m_pTextIndex;
+            m_pStatistics = copySrc.m_pStatistics;
+            RetainChangeset();
         }
         return *this;
     }
@@ -160,8 +509,18 @@ namespace pserv
     {
         m_lookup = std::move(moveSrc.m_lookup);
         m_vector = std::move(moveSrc.m_vector);
-        moveSrc.m_lookup.clear();
+        m_removedStableKeys = std::move(moveSrc.m_removedStableKeys);
+        m_changeset = std::exchange(moveSrc.m_changeset, DataObjectChangeset{});
+        m_secondaryIndexes = std::exchange(moveSrc.m_secondaryIndexes, {});
+        m_LastSeenGeneration = moveSrc.m_LastSeenGeneration;
+        m_refreshStartSerial = moveSrc.m_refreshStartSerial;
+        m_refreshStartSize = std::exchange(moveSrc.m_refreshStartSize, 0);
+        m_sortOrder = std::exchange(moveSrc.m_sortOrder, SortOrder{});
+        m_pTextIndex = std::move(moveSrc.m_pTextIndex);
+        m_pStatistics = std::move(moveSrc.m_pStatistics);
+        moveSrc.m_lookup.Clear();
         moveSrc.m_vector.clear();
+        moveSrc.m_removedStableKeys.clear();
     }
 
     DataObjectContainer& DataObjectContainer::operator=(DataObjectContainer&& moveSrc)
@@ -171,22 +530,43 @@ namespace pserv
             Clear();
             m_lookup = std::move(moveSrc.m_lookup);
             m_vector = std::move(moveSrc.m_vector);
-            moveSrc.m_lookup.clear();
+            m_removedStableKeys = std::move(moveSrc.m_removedStableKeys);
+            m_changeset = std::exchange(moveSrc.m_changeset, DataObjectChangeset{});
+            m_secondaryIndexes = std::exchange(moveSrc.m_secondaryIndexes, {});
+            m_LastSeenGeneration = moveSrc.m_LastSeenGeneration;
+            m_refreshStartSerial = moveSrc.m_refreshStartSerial;
+            m_refreshStartSize = std::exchange(moveSrc.m_refreshStartSize, 0);
+            m_sortOrder = std::exchange(moveSrc.m_sortOrder, SortOrder{});
+            m_pTextIndex = std::move(moveSrc.m_pTextIndex);
+            m_pStatistics = std::move(moveSrc.m_pStatistics);
+            moveSrc.m_lookup.Clear();
             moveSrc.m_vector.clear();
+            moveSrc.m_removedStableKeys.clear();
         }
         return *this;
     }
 
-    
-
     void DataObjectContainer::Clear()
     {
-        m_lookup.clear();
+        m_lookup.Clear();
         for (const auto dataObject : m_vector)
         {
             assert(dataObject != nullptr);
             dataObject->Release(REFCOUNT_DEBUG_ARGS);
         }
         m_vector.clear();
+        m_removedStableKeys.clear();
+        for (auto &secondaryIndex : m_secondaryIndexes)
+        {
+            secondaryIndex.Clear();
+        }
+        if (m_pTextIndex)
+        {
+            // Stays enabled, but must not empty an index a copy still uses
+            m_pTextIndex = std::make_shared<TrigramIndex>();
+        }
+        m_pStatistics.reset();
+        ReleaseChangeset();
+        m_refreshStartSize = 0;
     }
 } // namespace pserv
@@ -0,0 +1,134 @@
+#include "precomp.h"
+#include <core/data_object_selection.h>
+
+namespace pserv
+{
+    void DataObjectSelection::Clear() noexcept
+    {
+        m_keys.clear();
+        m_keySet.clear();
+        m_anchor.reset();
+        ++m_revision;
+    }
+
+    void DataObjectSelection::Add(const StableKey &stableKey)
+    {
+        if (m_keySet.insert(stableKey).second)
+        {
+            m_keys.push_back(stableKey);
+        }
+    }
+
+    void DataObjectSelection::SelectOnly(const DataObject *dataObject)
+    {
+        const auto stableKey{dataObject->GetStableKey()};
+        m_keys.clear();
+        m_keySet.clear();
+        Add(stableKey);
+        m_anchor = stableKey;
+        ++m_revision;
+    }
+
+    void DataObjectSelection::Toggle(const DataObject *dataObject)
+    {
+        const auto stableKey{dataObject->GetStableKey()};
+        if (m_keySet.erase(stableKey) != 0)
+        {
+            std::erase(m_keys, stableKey);
+        }
+        else
+        {
+            Add(stableKey);
+        }
+        m_anchor = stableKey;
+        ++m_revision;
+    }
+
+    bool DataObjectSelection::SelectRange(const DataObjectContainer &snapshot, std::span<DataObject *const> rows, const DataObject *target)
+    {
+        if (!m_anchor)
+            return false;
+
+        const DataObject *anchor = snapshot.Find(*m_anchor);
+        const auto anchorIt = std::ranges::find(rows, anchor);
+        const auto targetIt = std::ranges::find(rows, target);
+        if (anchor == nullptr || anchorIt == rows.end() || targetIt == rows.end())
+            return false;
+
+        const auto first = std::min(anchorIt, targetIt);
+        const auto last = std::max(anchorIt, targetIt);
+        m_keys.clear();
+        m_keySet.clear();
+        for (auto it = first; it <= last; ++it)
+        {
+            Add((*it)->GetStableKey());
+        }
+        ++m_revision;
+        return true;
+    }
+
+    void DataObjectSelection::RetainVisible(const DataObjectContainer &snapshot, std::span<DataObject *const> rows)
+    {
+        if (m_keys.empty() && !m_anchor)
+            return;
+
+        // Resolve the (few) selected keys to objects once; the pass over the rows then compares
+        // pointers only, instead of computing the stable key of every row.
+        std::unordered_map<const DataObject *, StableKey> resolved;
+        for (const auto &stableKey : m_keys)
+        {
+            if (const auto dataObject = snapshot.Find(stableKey))
+            {
+                resolved.emplace(dataObject, stableKey);
+            }
+        }
+        const DataObject *anchor = m_anchor ? snapshot.Find(*m_anchor) : nullptr;
+
+        std::unordered_set<StableKey, StableKeyHash> visible;
+        bool bAnchorVisible = false;
+        if (rows.size() == snapshot.GetSize())
+        {
+            // Unfiltered: everything the snapshot contains is visible
+            for (const auto &[dataObject, stableKey] : resolved)
+            {
+                visible.insert(stableKey);
+            }
+            bAnchorVisible = anchor != nullptr;
+        }
+        else
+        {
+            for (const auto *dataObject : rows)
+            {
+                if (const auto it = resolved.find(dataObject); it != resolved.end())
+                {
+                    visible.insert(it->second);
+                }
+                bAnchorVisible = bAnchorVisible || dataObject == anchor;
+            }
+        }
+        if (!bAnchorVisible)
+        {
+            m_anchor.reset();
+        }
+
+        if (visible.size() != m_keys.size())
+        {
+            std::erase_if(m_keys, [&visible](const StableKey &stableKey) { return !visible.contains(stableKey); });
+            m_keySet = std::move(visible);
+            ++m_revision;
+        }
+    }
+
+    void DataObjectSelection::Resolve(const DataObjectContainer &snapshot, std::vector<DataObject *> &objects) const
+    {
+        objects.reserve(objects.size() + m_keys.size());
+        for (const auto &stableKey : m_keys)
+        {
+            if (const auto dataObject = snapshot.Find(stableKey))
+            {
+                dataObject->Retain(REFCOUNT_DEBUG_ARGS);
+                objects.push_back(dataObject);
+            }
+        }
+    }
+} // namespace pserv
@@ -0,0 +1,85 @@
+/// @file data_object_selection.h
+/// @brief Selection of rows, keyed by stable key.
+///
+/// The selection stores the StableKey of every selected object instead of a
+/// reference to the object. Membership tests are O(1), and the selection
+/// carries over to the next snapshot after a refresh or sort unchanged, without
+/// swapping object references. Actions still receive the selected objects as
+/// an ordered vector: Resolve() looks them up in the displayed snapshot.
+#pragma once
+
+#include <core/data_object_container.h>
+
+namespace pserv
+{
+    /// @brief Ordered set of selected objects, identified by DataObject::GetStableKey().
+    class DataObjectSelection final
+    {
+    public:
+        /// @brief Check whether an object is selected, in O(1).
+        bool Contains(const DataObject *dataObject) const
+        {
+            return m_keySet.contains(dataObject->GetStableKey());
+        }
+
+        /// @brief Check whether nothing is selected.
+        bool IsEmpty() const noexcept
+        {
+            return m_keys.empty();
+        }
+
+        /// @brief Number of selected objects.
+        size_t GetSize() const noexcept
+        {
+            return m_keys.size();
+        }
+
+        /// @brief Selected keys, in selection order.
+        std::span<const StableKey> GetKeys() const noexcept
+        {
+            return m_keys;
+        }
+
+        /// @brief Counter that changes whenever the selection changes.
+        uint64_t GetRevision() const noexcept
+        {
+            return m_revision;
+        }
+
+        /// @brief Deselect everything and forget the anchor.
+        void Clear() noexcept;
+
+        /// @brief Select just this object and make it the anchor (plain click).
+        void SelectOnly(const DataObject *dataObject);
+
+        /// @brief Add or remove an object and make it the anchor (Ctrl+click).
+        void Toggle(const DataObject *dataObject);
+
+        /// @brief Select the rows between the anchor and @p target, inclusive (Shift+click).
+        /// Replaces the selection; the anchor stays, so the range can be adjusted by further clicks.
+        /// @param snapshot The snapshot @p rows belong to.
+        /// @param rows The displayed rows, in display order.
+        /// @param target The clicked row.
+        /// @return false (nothing changed) if there is no anchor or it is not among @p rows.
+        bool SelectRange(const DataObjectContainer &snapshot, std::span<DataObject *const> rows, const DataObject *target);
+
+        /// @brief Deselect everything that is not among the displayed rows (e.g. after filtering).
+        /// Runs in O(rows + selection); call it only when the rows changed.
+        /// @param snapshot The snapshot @p rows belong to.
+        /// @param rows The displayed rows.
+        void RetainVisible(const DataObjectContainer &snapshot, std::span<DataObject *const> rows);
+
+        /// @brief Look up the selected objects in a snapshot, in selection order.
+        /// @param snapshot The snapshot to resolve the keys in; keys it does not contain are skipped.
+        /// @param objects Receives the objects, each Retain()ed for the caller.
+        void Resolve(const DataObjectContainer &snapshot, std::vector<DataObject *> &objects) const;
+
+    private:
+        void Add(const StableKey &stableKey);
+
+        std::vector<StableKey> m_keys;                          ///< Selected keys, in selection order.
+        std::unordered_set<StableKey, StableKeyHash> m_keySet;  ///< Same keys, for membership tests.
+        std::optional<StableKey> m_anchor;                      ///< Last clicked row, start of Shift+click ranges.
+        uint64_t m_revision{0};                                 ///< See GetRevision().
+    };
+} // namespace pserv
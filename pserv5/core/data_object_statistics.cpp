@@ -0,0 +1,53 @@
+#include "precomp.h"
+#include <core/data_object_statistics.h>
+
+namespace pserv
+{
+    void DataObjectStatistics::Update(const DataObject *dataObject, const Values &values)
+    {
+        const auto [it, inserted] = m_values.try_emplace(dataObject, values);
+        if (!inserted)
+        {
+            Subtract(it->second);
+            it->second = values;
+        }
+        Add(values);
+    }
+
+    void DataObjectStatistics::Erase(const DataObject *dataObject)
+    {
+        if (const auto it = m_values.find(dataObject); it != m_values.end())
+        {
+            Subtract(it->second);
+            m_values.erase(it);
+        }
+    }
+
+    void DataObjectStatistics::Clear() noexcept
+    {
+        m_values.clear();
+        m_totals = Values{};
+    }
+
+    void DataObjectStatistics::Add(const Values &values) noexcept
+    {
+        m_totals.HighlightedCount += values.HighlightedCount;
+        m_totals.DisabledCount += values.DisabledCount;
+        m_totals.PendingVisualStateCount += values.PendingVisualStateCount;
+        for (size_t index = 0; index < MAX_AGGREGATES; ++index)
+        {
+            m_totals.Aggregates[index] += values.Aggregates[index];
+        }
+    }
+
+    void DataObjectStatistics::Subtract(const Values &values) noexcept
+    {
+        m_totals.HighlightedCount -= values.HighlightedCount;
+        m_totals.DisabledCount -= values.DisabledCount;
+        m_totals.PendingVisualStateCount -= values.PendingVisualStateCount;
+        for (size_t index = 0; index < MAX_AGGREGATES; ++index)
+        {
+            m_totals.Aggregates[index] -= values.Aggregates[index];
+        }
+    }
+} // namespace pserv
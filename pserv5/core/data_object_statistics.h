@@ -0,0 +1,98 @@
+/// @file data_object_statistics.h
+/// @brief Status bar counters of a DataObjectContainer, maintained per refresh.
+///
+/// The status bar shows how many objects are highlighted or disabled and some
+/// per-controller sums (total working set, running services). Instead of
+/// asking the controller about every object every frame, the statistics keep
+/// the values each object contributed; a refresh subtracts the old values of
+/// the changed objects and adds their new ones (see DataController).
+#pragma once
+
+#include <core/data_object.h>
+#include <core/data_object_column.h>
+
+namespace pserv
+{
+    /// @brief A sum over all objects shown in the status bar, e.g. "running" services.
+    struct DataObjectAggregate final
+    {
+        std::string Label;        ///< Shown after the value, e.g. "working set".
+        ColumnDataType DataType;  ///< Formatting of the value (ColumnDataType::Size for bytes).
+    };
+
+    /// @brief Totals over the objects of a container, updated per object in O(1).
+    class DataObjectStatistics final
+    {
+    public:
+        /// @brief Maximum number of aggregates per controller.
+        static constexpr size_t MAX_AGGREGATES = 4;
+
+        /// @brief What one object contributes, or the totals over all objects.
+        struct Values final
+        {
+            size_t HighlightedCount{0};                        ///< Objects shown as VisualState::Highlighted.
+            size_t DisabledCount{0};                           ///< Objects shown as VisualState::Disabled.
+            size_t PendingVisualStateCount{0};                 ///< Objects whose visual state is not known yet.
+            std::array<uint64_t, MAX_AGGREGATES> Aggregates{}; ///< See DataObjectAggregate.
+        };
+
+        /// @brief Set what an object contributes, replacing its previous values.
+        void Update(const DataObject *dataObject, const Values &values);
+
+        /// @brief Remove the contribution of an object.
+        void Erase(const DataObject *dataObject);
+
+        /// @brief Remove all contributions.
+        void Clear() noexcept;
+
+        /// @brief Get the totals over all objects.
+        const Values &GetTotals() const noexcept
+        {
+            return m_totals;
+        }
+
+        /// @brief Check whether HighlightedCount and DisabledCount of the totals cover all objects.
+        /// False while the visual state of some objects depends on fields not loaded yet
+        /// (see DataController::IsVisualStateKnown()); the counts would then depend on which
+        /// objects happened to be loaded, so they should not be shown.
+        bool HasVisualStateCounts() const noexcept
+        {
+            return m_totals.PendingVisualStateCount == 0;
+        }
+
+        /// @brief Get the number of objects counted.
+        size_t GetObjectCount() const noexcept
+        {
+            return m_values.size();
+        }
+
+        /// @brief Get the refresh generation of the last changeset applied.
+        /// DataController recounts everything if the next changeset does not follow on.
+        uint64_t GetGeneration() const noexcept
+        {
+            return m_generation;
+        }
+
+        /// @brief Get the controller's statistics epoch the values were computed in.
+        uint64_t GetEpoch() const noexcept
+        {
+            return m_epoch;
+        }
+
+        /// @brief Record what the values are up to date with, see GetGeneration() and GetEpoch().
+        void SetBasis(uint64_t generation, uint64_t epoch) noexcept
+        {
+            m_generation = generation;
+            m_epoch = epoch;
+        }
+
+    private:
+        void Add(const Values &values) noexcept;
+        void Subtract(const Values &values) noexcept;
+
+        std::unordered_map<const DataObject *, Values> m_values; ///< Contribution of each object.
+        Values m_totals;                                         ///< Sum of m_values.
+        uint64_t m_generation{0};                                ///< See GetGeneration().
+        uint64_t m_epoch{0};                                     ///< See GetEpoch().
+    };
+} // namespace pserv
@@ -0,0 +1,82 @@
+/// @file data_view.h
+/// @brief Per-controller cache of the rows the main window displays.
+///
+/// The rows of a view only change when its controller publishes a new
+/// snapshot (after a refresh or a sort) or when the filter text changes.
+/// DataView keeps the filtered, sorted rows of one controller between frames,
+/// so a frame in which none of these changed costs a few comparisons instead
+/// of a pass over the data, and switching back to a tab shows its rows without
+/// filtering again. The rows are computed by a BackgroundFilter, so filtering
+/// a large view does not stall the UI either. The formatted cell texts of the
+/// displayed rows are kept as well (see CellTextCache).
+#pragma once
+
+#include <core/background_filter.h>
+#include <core/cell_text_cache.h>
+#include <core/data_controller.h>
+
+namespace pserv
+{
+    /// @brief Filtered, sorted rows of one DataController.
+    class DataView final
+    {
+    public:
+        /// @param controller The controller whose snapshots are displayed; must outlive the view.
+        explicit DataView(const DataController &controller)
+            : m_controller{controller}
+        {
+        }
+
+        /// @brief Bring the rows up to date with the latest snapshot and the filter text.
+        /// Call once per frame; O(1) unless the snapshot or the filter changed.
+        /// @return true if GetRows() changed since the last call.
+        bool Update(std::string_view filter)
+        {
+            m_cellTexts.EndFrame();
+            return m_filter.Update(m_controller.GetSnapshot(), filter, m_controller.GetColumns());
+        }
+
+        /// @brief Check whether rows have been computed yet (false until the first result is ready).
+        bool HasRows() const noexcept
+        {
+            return m_filter.HasResultFor(m_controller.GetColumns());
+        }
+
+        /// @brief Get the snapshot the rows belong to; it keeps the row objects alive.
+        /// May be older than the controller's latest snapshot while filtering.
+        const std::shared_ptr<const DataObjectContainer> &GetSnapshot() const noexcept
+        {
+            return m_filter.GetSnapshot();
+        }
+
+        /// @brief Get the rows matching the filter, in display (sort) order.
+        std::span<DataObject *const> GetRows() const noexcept
+        {
+            return m_filter.GetMatches();
+        }
+
+        /// @brief Get the text of a cell of one of the rows, formatted only when the object changed.
+        /// @return Valid until the next GetCellText() for the same object or the next Update().
+        const std::string &GetCellText(const DataObject *dataObject, int column)
+        {
+            return m_cellTexts.Get(*dataObject, column);
+        }
+
+        /// @brief Check whether newer rows are being computed in the background.
+        bool IsFiltering() const noexcept
+        {
+            return m_filter.IsFiltering();
+        }
+
+        /// @brief Get the query the rows were filtered with (e.g. to show its error).
+        const FilterQuery &GetQuery() const noexcept
+        {
+            return m_filter.GetQuery();
+        }
+
+    private:
+        const DataController &m_controller;
+        BackgroundFilter m_filter;
+        CellTextCache m_cellTexts;
+    };
+} // namespace pserv
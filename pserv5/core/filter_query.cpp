@@ -0,0 +1,621 @@
+#include "precomp.h"
+#include <core/filter_query.h>
+#include <core/sort_key.h>
+#include <utils/string_utils.h>
+
+#include <cmath>
+#include <limits>
+
+namespace pserv
+{
+    static bool IsIdentifierChar(char c) noexcept
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    static bool EqualsIgnoreCase(std::string_view a, std::string_view b) noexcept
+    {
+        return a.size() == b.size() && utils::FindIgnoreCase(a, b) == 0;
+    }
+
+    /// Find a column by binding name or by display name without spaces ("WorkingSetSize", "workingset").
+    static int FindQueryColumn(std::string_view name, const std::vector<DataObjectColumn> &columns)
+    {
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            std::string displayName = columns[i].DisplayName;
+            std::erase(displayName, ' ');
+            if (EqualsIgnoreCase(columns[i].BindingName, name) || EqualsIgnoreCase(displayName, name))
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    /// Recursive-descent parser: or := and ("OR" and)*, and := unary (["AND"] unary)*,
+    /// unary := "NOT" unary | "(" or ")" | term. Errors are thrown as std::invalid_argument.
+    class FilterQuery::Parser final
+    {
+    public:
+        Parser(std::string_view text, const std::vector<DataObjectColumn> &columns)
+            : m_text{text}
+            , m_columns{columns}
+        {
+        }
+
+        /// Parse the whole text; sets bStructured if an operator, a predicate or a quoted word was found.
+        /// Otherwise nothing is parsed: the text is searched for as typed.
+        Node Parse(bool &bStructured)
+        {
+            Tokenize();
+            // Parentheses alone do not make a query: "C:\Program Files (x86)" is a path, not a group
+            bStructured = std::ranges::any_of(m_tokens, [](const Token &token)
+                {
+                    return token.Kind == TokenKind::Predicate || token.Kind == TokenKind::And || token.Kind == TokenKind::Or ||
+                           token.Kind == TokenKind::Not || token.bQuoted;
+                });
+            if (!bStructured)
+            {
+                return {};
+            }
+
+            Node root = ParseOr();
+            if (Peek().Kind != TokenKind::End)
+            {
+                Fail("unexpected ')'", Peek().Position);
+            }
+            OrderByCost(root);
+            return root;
+        }
+
+    private:
+        enum class TokenKind
+        {
+            Word,
+            Predicate,
+            And,
+            Or,
+            Not,
+            Open,
+            Close,
+            End
+        };
+
+        struct Token
+        {
+            TokenKind Kind{TokenKind::End};
+            size_t Position{0};
+            std::string Text;      ///< Word text or predicate value.
+            bool bQuoted{false};   ///< Word was written in quotes.
+            int ColumnIndex{-1};   ///< Predicate column.
+            CompareOp Op{CompareOp::Contains};
+        };
+
+        [[noreturn]] static void Fail(const std::string &message, size_t position)
+        {
+            throw std::invalid_argument(std::format("{} at position {}", message, position + 1));
+        }
+
+        static std::string Unquote(std::string_view text)
+        {
+            if (text.size() >= 2 && text.front() == '"' && text.back() == '"')
+                return std::string{text.substr(1, text.size() - 2)};
+            return std::string{text};
+        }
+
+        /// Read up to the next whitespace, keeping quoted parts (which may contain spaces) together.
+        std::string_view ReadWord(size_t &pos) const
+        {
+            const size_t start = pos;
+            while (pos < m_text.size() && !std::isspace(static_cast<unsigned char>(m_text[pos])))
+            {
+                if (m_text[pos] == '"')
+                {
+                    const size_t closing = m_text.find('"', pos + 1);
+                    if (closing == std::string_view::npos)
+                        Fail("missing closing quote", pos);
+                    pos = closing;
+                }
+                ++pos;
+            }
+            return m_text.substr(start, pos - start);
+        }
+
+        void Tokenize()
+        {
+            size_t pos = 0;
+            int depth = 0;
+            while (true)
+            {
+                while (pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[pos])))
+                    ++pos;
+                if (pos == m_text.size())
+                    break;
+
+                Token token;
+                token.Position = pos;
+                const char c = m_text[pos];
+                const char next = pos + 1 < m_text.size() ? m_text[pos + 1] : '\0';
+                if (c == '(')
+                {
+                    token.Kind = TokenKind::Open;
+                    ++depth;
+                    ++pos;
+                }
+                else if (c == ')' && depth > 0)
+                {
+                    token.Kind = TokenKind::Close;
+                    --depth;
+                    ++pos;
+                }
+                else if ((c == '|' || c == '&') && (next == '\0' || std::isspace(static_cast<unsigned char>(next))))
+                {
+                    token.Kind = c == '|' ? TokenKind::Or : TokenKind::And;
+                    ++pos;
+                }
+                else if (c == '!' && next != '\0' && next != '=' && !std::isspace(static_cast<unsigned char>(next)))
+                {
+                    token.Kind = TokenKind::Not;
+                    ++pos;
+                }
+                else
+                {
+                    auto word = ReadWord(pos);
+
+                    // "(Name:a OR Name:b)": give closing parentheses that belong to a group back
+                    int unbalanced = static_cast<int>(std::ranges::count(word, ')') - std::ranges::count(word, '('));
+                    while (depth > 0 && unbalanced > 0 && word.size() > 1 && word.back() == ')')
+                    {
+                        word.remove_suffix(1);
+                        --pos;
+                        --unbalanced;
+                    }
+                    ClassifyWord(word, token);
+                }
+                m_tokens.push_back(std::move(token));
+            }
+
+            Token end;
+            end.Position = m_text.size();
+            m_tokens.push_back(end);
+        }
+
+        void ClassifyWord(std::string_view word, Token &token) const
+        {
+            if (word == "AND" || word == "OR" || word == "NOT")
+            {
+                token.Kind = word == "AND" ? TokenKind::And : (word == "OR" ? TokenKind::Or : TokenKind::Not);
+                return;
+            }
+
+            token.Kind = TokenKind::Word;
+            token.bQuoted = word.size() >= 2 && word.front() == '"' && word.back() == '"';
+            token.Text = Unquote(word);
+
+            // <column><op><value>
+            size_t nameLength = 0;
+            while (nameLength < word.size() && IsIdentifierChar(word[nameLength]))
+                ++nameLength;
+            if (nameLength == 0 || nameLength == word.size())
+                return;
+
+            static constexpr std::pair<std::string_view, CompareOp> operators[] = {
+                {"!=", CompareOp::NotEqual},
+                {"<=", CompareOp::LessEqual},
+                {">=", CompareOp::GreaterEqual},
+                {":", CompareOp::Contains},
+                {"=", CompareOp::Equal},
+                {"<", CompareOp::Less},
+                {">", CompareOp::Greater},
+                {"~", CompareOp::Regex},
+            };
+            const auto rest = word.substr(nameLength);
+            const auto op = std::ranges::find_if(operators, [rest](const auto &entry) { return rest.starts_with(entry.first); });
+            if (op == std::end(operators))
+                return;
+
+            const auto name = word.substr(0, nameLength);
+            const int columnIndex = FindQueryColumn(name, m_columns);
+            if (columnIndex < 0)
+            {
+                // "C:\Windows" or "--type=renderer" are text; "Foo>5" is most likely a typo
+                if (op->second == CompareOp::Contains || op->second == CompareOp::Equal)
+                    return;
+                Fail(std::format("unknown column '{}'", name), token.Position);
+            }
+
+            const auto value = rest.substr(op->first.size());
+            if (value.empty())
+                Fail(std::format("missing value after '{}{}'", name, op->first), token.Position);
+
+            token.Kind = TokenKind::Predicate;
+            token.ColumnIndex = columnIndex;
+            token.Op = op->second;
+            token.Text = Unquote(value);
+        }
+
+        /// Rough evaluation cost of a node: cached search text and typed numbers are cheap,
+        /// text columns copy a string, regular expressions are expensive.
+        int GetCost(const Node &node) const
+        {
+            switch (node.Kind)
+            {
+            case NodeKind::Compare:
+                if (node.Op == CompareOp::Regex)
+                    return 4;
+                return SortKey::IsNumeric(m_columns[node.ColumnIndex].DataType) ? 1 : 2;
+            case NodeKind::And:
+            case NodeKind::Or:
+            case NodeKind::Not:
+                return std::ranges::max(node.Children | std::views::transform([this](const Node &child) { return GetCost(child); }));
+            default:
+                return 1;
+            }
+        }
+
+        /// Evaluate cheap operands of AND/OR first, so short-circuiting skips the expensive ones.
+        void OrderByCost(Node &node) const
+        {
+            for (auto &child : node.Children)
+            {
+                OrderByCost(child);
+            }
+            if (node.Kind == NodeKind::And || node.Kind == NodeKind::Or)
+            {
+                std::ranges::stable_sort(node.Children, {}, [this](const Node &child) { return GetCost(child); });
+            }
+        }
+
+        const Token &Peek() const
+        {
+            return m_tokens[m_next];
+        }
+
+        const Token &Consume()
+        {
+            return m_tokens[m_next++];
+        }
+
+        static Node Combine(NodeKind kind, Node left, Node right)
+        {
+            if (left.Kind == kind)
+            {
+                left.Children.push_back(std::move(right));
+                return left;
+            }
+            Node node;
+            node.Kind = kind;
+            node.Children.push_back(std::move(left));
+            node.Children.push_back(std::move(right));
+            return node;
+        }
+
+        Node ParseOr()
+        {
+            Node left = ParseAnd();
+            while (Peek().Kind == TokenKind::Or)
+            {
+                Consume();
+                left = Combine(NodeKind::Or, std::move(left), ParseAnd());
+            }
+            return left;
+        }
+
+        Node ParseAnd()
+        {
+            Node left = ParseUnary();
+            while (true)
+            {
+                const auto kind = Peek().Kind;
+                if (kind == TokenKind::And)
+                {
+                    Consume();
+                }
+                else if (kind != TokenKind::Word && kind != TokenKind::Predicate && kind != TokenKind::Not && kind != TokenKind::Open)
+                {
+                    break;
+                }
+                left = Combine(NodeKind::And, std::move(left), ParseUnary());
+            }
+            return left;
+        }
+
+        Node ParseUnary()
+        {
+            const Token &token = Consume();
+            Node node;
+            switch (token.Kind)
+            {
+            case TokenKind::Not:
+                node.Kind = NodeKind::Not;
+                node.Children.push_back(ParseUnary());
+                return node;
+
+            case TokenKind::Open:
+                node = ParseOr();
+                if (Consume().Kind != TokenKind::Close)
+                    Fail("missing ')'", token.Position);
+                return node;
+
+            case TokenKind::Word:
+                node.Kind = NodeKind::Text;
+                node.Text = token.Text;
+                return node;
+
+            case TokenKind::Predicate:
+                return MakePredicate(token);
+
+            default:
+                Fail("expected a search term", token.Position);
+            }
+        }
+
+        Node MakePredicate(const Token &token) const
+        {
+            Node node;
+            node.Kind = NodeKind::Compare;
+            node.ColumnIndex = token.ColumnIndex;
+            node.Op = token.Op;
+            node.Text = token.Text;
+            node.NumberLiteral = ParseNumber(token.Text);
+
+            const auto &column = m_columns[token.ColumnIndex];
+            const bool isOrdering = token.Op == CompareOp::Less || token.Op == CompareOp::LessEqual ||
+                                    token.Op == CompareOp::Greater || token.Op == CompareOp::GreaterEqual;
+            if (token.Op == CompareOp::Regex)
+            {
+                try
+                {
+                    node.pRegex = std::make_shared<const std::regex>(token.Text, std::regex::ECMAScript | std::regex::icase);
+                }
+                catch (const std::regex_error &e)
+                {
+                    Fail(std::format("invalid regular expression '{}' ({})", token.Text, e.what()), token.Position);
+                }
+            }
+            else if (isOrdering && SortKey::IsNumeric(column.DataType) && !node.NumberLiteral)
+            {
+                Fail(std::format("'{}' is not a number", token.Text), token.Position);
+            }
+            else if (isOrdering)
+            {
+                // Text ordering compares case-folded strings
+                node.Text = SortKey::CaseFold(node.Text);
+            }
+            return node;
+        }
+
+        std::string_view m_text;
+        const std::vector<DataObjectColumn> &m_columns;
+        std::vector<Token> m_tokens;
+        size_t m_next{0};
+    };
+
+    FilterQuery FilterQuery::Compile(std::string_view text, const std::vector<DataObjectColumn> &columns)
+    {
+        FilterQuery query;
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+            text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+            text.remove_suffix(1);
+        if (text.empty())
+            return query;
+
+        try
+        {
+            bool bStructured = false;
+            Node root = Parser{text, columns}.Parse(bStructured);
+            if (bStructured)
+            {
+                query.m_root = std::move(root);
+                return query;
+            }
+        }
+        catch (const std::invalid_argument &e)
+        {
+            query.m_error = e.what();
+        }
+
+        // Only words (or an invalid query): search for the text as typed, like MatchesFilter()
+        query.m_root.Kind = NodeKind::Text;
+        query.m_root.Text = text;
+        return query;
+    }
+
+    bool FilterQuery::Matches(const DataObject &dataObject) const
+    {
+        return Evaluate(m_root, dataObject);
+    }
+
+    std::vector<std::string_view> FilterQuery::GetRequiredTexts() const
+    {
+        std::vector<std::string_view> texts;
+        if (m_root.Kind == NodeKind::Text)
+        {
+            texts.push_back(m_root.Text);
+        }
+        else if (m_root.Kind == NodeKind::And)
+        {
+            for (const auto &child : m_root.Children)
+            {
+                if (child.Kind == NodeKind::Text)
+                {
+                    texts.push_back(child.Text);
+                }
+            }
+        }
+        return texts;
+    }
+
+    bool FilterQuery::Evaluate(const Node &node, const DataObject &dataObject)
+    {
+        switch (node.Kind)
+        {
+        case NodeKind::All:
+            return true;
+        case NodeKind::Text:
+            return dataObject.MatchesFilter(node.Text);
+        case NodeKind::Compare:
+            return EvaluateCompare(node, dataObject);
+        case NodeKind::And:
+            return std::ranges::all_of(node.Children, [&dataObject](const Node &child) { return Evaluate(child, dataObject); });
+        case NodeKind::Or:
+            return std::ranges::any_of(node.Children, [&dataObject](const Node &child) { return Evaluate(child, dataObject); });
+        case NodeKind::Not:
+            return !Evaluate(node.Children.front(), dataObject);
+        default:
+            return false;
+        }
+    }
+
+    bool FilterQuery::EvaluateCompare(const Node &node, const DataObject &dataObject)
+    {
+        if (node.Op == CompareOp::Regex)
+        {
+            return std::regex_search(dataObject.GetProperty(node.ColumnIndex), *node.pRegex);
+        }
+
+        int order;
+        const PropertyValue value = dataObject.GetTypedProperty(node.ColumnIndex);
+        if (std::holds_alternative<std::monostate>(value))
+        {
+            return node.Op == CompareOp::NotEqual;
+        }
+        else if (const auto *pText = std::get_if<std::string>(&value))
+        {
+            switch (node.Op)
+            {
+            case CompareOp::Contains:
+                return utils::ContainsIgnoreCase(*pText, node.Text);
+            case CompareOp::Equal:
+                return EqualsIgnoreCase(*pText, node.Text);
+            case CompareOp::NotEqual:
+                return !EqualsIgnoreCase(*pText, node.Text);
+            default:
+                order = SortKey::CaseFold(*pText).compare(node.Text);
+                break;
+            }
+        }
+        else if (node.NumberLiteral)
+        {
+            order = CompareNumbers(value, *node.NumberLiteral);
+        }
+        else
+        {
+            // Text on a numeric column (ordering was rejected by the parser): match the displayed value
+            const std::string displayed = dataObject.GetProperty(node.ColumnIndex);
+            switch (node.Op)
+            {
+            case CompareOp::Contains:
+                return utils::ContainsIgnoreCase(displayed, node.Text);
+            case CompareOp::Equal:
+                return EqualsIgnoreCase(displayed, node.Text);
+            default:
+                return !EqualsIgnoreCase(displayed, node.Text);
+            }
+        }
+
+        switch (node.Op)
+        {
+        case CompareOp::Contains:
+        case CompareOp::Equal:
+            return order == 0;
+        case CompareOp::NotEqual:
+            return order != 0;
+        case CompareOp::Less:
+            return order < 0;
+        case CompareOp::LessEqual:
+            return order <= 0;
+        case CompareOp::Greater:
+            return order > 0;
+        case CompareOp::GreaterEqual:
+            return order >= 0;
+        default:
+            return false;
+        }
+    }
+
+    std::optional<FilterQuery::Number> FilterQuery::ParseNumber(std::string_view text)
+    {
+        static constexpr std::pair<std::string_view, uint64_t> suffixes[] = {
+            {"tb", 1ull << 40}, {"gb", 1ull << 30}, {"mb", 1ull << 20}, {"kb", 1ull << 10},
+            {"t", 1ull << 40}, {"g", 1ull << 30}, {"m", 1ull << 20}, {"k", 1ull << 10}, {"b", 1},
+        };
+
+        Number number;
+        if (!text.empty() && (text.front() == '-' || text.front() == '+'))
+        {
+            number.IsNegative = text.front() == '-';
+            text.remove_prefix(1);
+        }
+
+        uint64_t multiplier = 1;
+        const std::string lowerText = utils::ToLower(text);
+        for (const auto &[suffix, factor] : suffixes)
+        {
+            if (lowerText.size() > suffix.size() && lowerText.ends_with(suffix))
+            {
+                multiplier = factor;
+                text.remove_suffix(suffix.size());
+                break;
+            }
+        }
+        if (text.empty() || !std::isdigit(static_cast<unsigned char>(text.front())))
+            return std::nullopt;
+
+        const char *pEnd = text.data() + text.size();
+        uint64_t integer = 0;
+        const auto integerResult = std::from_chars(text.data(), pEnd, integer);
+        if (integerResult.ec == std::errc{} && integerResult.ptr == pEnd)
+        {
+            if (integer > std::numeric_limits<uint64_t>::max() / multiplier)
+                return std::nullopt;
+            number.Magnitude = integer * multiplier;
+            number.Value = static_cast<double>(number.Magnitude);
+        }
+        else
+        {
+            double fraction = 0.0;
+            const auto fractionResult = std::from_chars(text.data(), pEnd, fraction);
+            if (fractionResult.ec != std::errc{} || fractionResult.ptr != pEnd)
+                return std::nullopt;
+
+            // "1.5GB" is a whole number of bytes; "0.5" on a count column is not
+            number.Value = fraction * static_cast<double>(multiplier);
+            number.IsInteger = number.Value == std::floor(number.Value) && number.Value < 18446744073709551616.0;
+            if (number.IsInteger)
+                number.Magnitude = static_cast<uint64_t>(number.Value);
+        }
+        if (number.IsNegative)
+            number.Value = -number.Value;
+        return number;
+    }
+
+    int FilterQuery::CompareNumbers(const PropertyValue &value, const Number &literal) noexcept
+    {
+        const auto compare = [](auto a, auto b) { return a < b ? -1 : (a > b ? 1 : 0); };
+        const bool literalIsNegative = literal.IsNegative && literal.Magnitude != 0;
+
+        if (const auto *pUnsigned = std::get_if<uint64_t>(&value))
+        {
+            if (!literal.IsInteger)
+                return compare(static_cast<double>(*pUnsigned), literal.Value);
+            if (literalIsNegative)
+                return 1;
+            return compare(*pUnsigned, literal.Magnitude);
+        }
+        if (const auto *pSigned = std::get_if<int64_t>(&value))
+        {
+            if (!literal.IsInteger)
+                return compare(static_cast<double>(*pSigned), literal.Value);
+            if (*pSigned >= 0)
+                return literalIsNegative ? 1 : compare(static_cast<uint64_t>(*pSigned), literal.Magnitude);
+            if (!literalIsNegative)
+                return -1;
+            // Both negative: the larger magnitude is the smaller number
+            return compare(literal.Magnitude, 0 - static_cast<uint64_t>(*pSigned));
+        }
+        return 0;
+    }
+} // namespace pserv
@@ -0,0 +1,128 @@
+/// @file filter_query.h
+/// @brief Structured filter queries shared by the GUI filter box and `pservc --where`.
+///
+/// A query is a list of terms combined with AND (implicit, or `AND` / `&`),
+/// OR (`OR` / `|`), NOT (`NOT` / `!`) and parentheses. A term is either plain
+/// text, matched like DataObject::MatchesFilter() against all searchable
+/// fields, or a column predicate `<column><op><value>`:
+///
+/// | Operator | Meaning |
+/// |----------|---------|
+/// | `:`  | Contains (text), equals (numbers) |
+/// | `=`, `!=` | Equals / differs, ignoring case |
+/// | `<`, `<=`, `>`, `>=` | Numeric comparison for numeric columns, case-insensitive ordering for text |
+/// | `~`  | Regular expression search (ECMAScript, ignoring case) |
+///
+/// Columns are named by binding name or display name without spaces, ignoring
+/// case. Numbers accept a size suffix (K/KB, M/MB, G/GB, T/TB; 1024-based), so
+/// `User:SYSTEM WorkingSetSize>500MB Name~^svc` finds SYSTEM processes whose
+/// name starts with "svc" and that use more than 500 MB.
+///
+/// The text is compiled once into a predicate tree. Numeric predicates compare
+/// DataObject::GetTypedProperty() values directly, without formatting them.
+#pragma once
+
+#include <core/data_object.h>
+#include <core/data_object_column.h>
+
+namespace pserv
+{
+    /// @brief Compiled filter query.
+    class FilterQuery final
+    {
+    public:
+        /// @brief The empty query; matches every object.
+        FilterQuery() = default;
+
+        /// @brief Compile query text for the given columns.
+        /// @param text The query text.
+        /// @param columns The columns of the controller whose objects will be matched.
+        /// @return The compiled query. Text without any query syntax compiles to a plain
+        ///         substring filter, exactly like MatchesFilter(); parentheses only group if
+        ///         there is an operator, a predicate or a quoted word, too. If the text is not a valid
+        ///         query, the result is a plain substring filter too and GetError() says why.
+        static FilterQuery Compile(std::string_view text, const std::vector<DataObjectColumn> &columns);
+
+        /// @brief Check whether an object satisfies the query.
+        bool Matches(const DataObject &dataObject) const;
+
+        /// @brief Check whether the query matches everything.
+        bool IsEmpty() const noexcept
+        {
+            return m_root.Kind == NodeKind::All;
+        }
+
+        /// @brief Check whether the query is a single substring filter over all searchable fields.
+        /// Plain queries narrow monotonically: a plain query whose text contains another plain
+        /// query's text matches a subset of its objects.
+        bool IsPlainText() const noexcept
+        {
+            return m_root.Kind == NodeKind::All || m_root.Kind == NodeKind::Text;
+        }
+
+        /// @brief Get the plain-text terms every matching object must contain.
+        /// These are the query itself if it is plain text, or the plain-text operands of a
+        /// top-level AND; an index can use them to preselect candidates (see TrigramIndex).
+        /// @return Views into this query, valid as long as it is alive; empty if there are none.
+        std::vector<std::string_view> GetRequiredTexts() const;
+
+        /// @brief Get the parse error of the text passed to Compile(), or an empty string.
+        const std::string &GetError() const noexcept
+        {
+            return m_error;
+        }
+
+    private:
+        enum class NodeKind
+        {
+            All,     ///< Matches everything (empty query).
+            Text,    ///< Substring of the searchable fields.
+            Compare, ///< Column predicate.
+            And,
+            Or,
+            Not
+        };
+
+        enum class CompareOp
+        {
+            Contains,
+            Equal,
+            NotEqual,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual,
+            Regex
+        };
+
+        /// A number literal; integers are compared exactly, fractions as double.
+        struct Number
+        {
+            bool IsInteger{true};
+            bool IsNegative{false};
+            uint64_t Magnitude{0};
+            double Value{0.0};
+        };
+
+        struct Node
+        {
+            NodeKind Kind{NodeKind::All};
+            std::vector<Node> Children;              ///< Operands of And/Or/Not.
+            int ColumnIndex{-1};                     ///< Column of a Compare node.
+            CompareOp Op{CompareOp::Contains};       ///< Operator of a Compare node.
+            std::string Text;                        ///< Needle or literal (Text/Compare).
+            std::optional<Number> NumberLiteral;     ///< Text parsed as number, if it is one.
+            std::shared_ptr<const std::regex> pRegex; ///< Compiled pattern of a Regex node.
+        };
+
+        class Parser;
+
+        static bool Evaluate(const Node &node, const DataObject &dataObject);
+        static bool EvaluateCompare(const Node &node, const DataObject &dataObject);
+        static std::optional<Number> ParseNumber(std::string_view text);
+        static int CompareNumbers(const PropertyValue &value, const Number &literal) noexcept;
+
+        Node m_root;
+        std::string m_error;
+    };
+} // namespace pserv
@@ -0,0 +1,96 @@
+#include "precomp.h"
+#include <core/incremental_filter.h>
+
+namespace pserv
+{
+    /// Rows verified between two checks for cancellation.
+    static constexpr size_t CANCEL_CHECK_INTERVAL = 4096;
+
+    /// Append the rows matching @p query to @p matches, in order.
+    /// @return false if @p stopToken requested a stop before all rows were checked.
+    template <typename Rows>
+    static bool CollectMatches(const FilterQuery &query, const Rows &rows, std::vector<DataObject *> &matches, const std::stop_token &stopToken)
+    {
+        size_t checked = 0;
+        for (auto *dataObject : rows)
+        {
+            if (++checked % CANCEL_CHECK_INTERVAL == 0 && stopToken.stop_requested())
+                return false;
+            if (query.Matches(*dataObject))
+            {
+                matches.push_back(dataObject);
+            }
+        }
+        return true;
+    }
+
+    const std::vector<DataObject *> &IncrementalFilter::Apply(const std::shared_ptr<const DataObjectContainer> &snapshot,
+        std::string_view filter,
+        const std::vector<DataObjectColumn> &columns,
+        std::stop_token stopToken)
+    {
+        std::vector<DataObject *> rows;
+        if (filter != m_filter || &columns != m_pColumns)
+        {
+            const bool wasPlainText = m_query.IsPlainText();
+            const bool isSameColumns = &columns == m_pColumns;
+            const std::string previousFilter = std::exchange(m_filter, std::string{filter});
+            m_query = FilterQuery::Compile(filter, columns);
+            m_pColumns = &columns;
+
+            // Holding the snapshot pins its identity: a new refresh or sort result is always a
+            // different object, so pointer equality means the cached matches are still valid.
+            // Anything matching a longer plain filter also matches the previous one.
+            if (snapshot == m_snapshot && isSameColumns && wasPlainText && m_query.IsPlainText() &&
+                utils::ContainsIgnoreCase(filter, previousFilter))
+            {
+                rows.swap(m_matches);
+                if (!CollectMatches(m_query, rows, m_matches, stopToken))
+                {
+                    Reset();
+                }
+                return m_matches;
+            }
+        }
+        else if (snapshot == m_snapshot)
+        {
+            return m_matches;
+        }
+
+        m_snapshot = snapshot;
+        m_matches.clear();
+        if (m_snapshot == nullptr)
+            return m_matches;
+
+        bool bCompleted = true;
+        if (m_query.IsEmpty())
+        {
+            m_matches.assign(m_snapshot->begin(), m_snapshot->end());
+        }
+        else if (const auto needles = m_query.GetRequiredTexts(); m_snapshot->FindTextCandidates(needles, rows))
+        {
+            // The text index preselected the objects that can contain the needles
+            bCompleted = CollectMatches(m_query, rows, m_matches, stopToken);
+        }
+        else
+        {
+            bCompleted = CollectMatches(m_query, *m_snapshot, m_matches, stopToken);
+        }
+
+        // A partial result must not be narrowed or returned as cached by the next call
+        if (!bCompleted)
+        {
+            Reset();
+        }
+        return m_matches;
+    }
+
+    void IncrementalFilter::Reset() noexcept
+    {
+        m_snapshot.reset();
+        m_pColumns = nullptr;
+        m_filter.clear();
+        m_query = FilterQuery{};
+        m_matches.clear();
+    }
+} // namespace pserv
@@ -0,0 +1,52 @@
+/// @file incremental_filter.h
+/// @brief Filter result set that is narrowed instead of recomputed while the user types.
+///
+/// Typing "svc" -> "svch" -> "svchost" into the filter box only ever removes
+/// rows: every row matching "svch" also matches "svc". IncrementalFilter keeps
+/// the last filter text and its matches, and rescans just those matches when
+/// the new filter contains the previous one. The whole snapshot is scanned
+/// again only when the filter is shortened or edited elsewhere, or when a
+/// refresh or sort published a different snapshot. Structured queries (see
+/// FilterQuery) are not monotonic in their text and are always rescanned when
+/// the text changes. Full scans use the snapshot's text index, if it has one
+/// (see DataObjectContainer::EnableTextIndex()), to verify only the candidates.
+#pragma once
+
+#include <core/data_object_container.h>
+#include <core/filter_query.h>
+
+namespace pserv
+{
+    /// @brief Cached result of a FilterQuery over one snapshot.
+    class IncrementalFilter final
+    {
+    public:
+        /// @brief Get the objects of a snapshot that match a filter, in snapshot order.
+        /// @param snapshot Snapshot to filter; kept alive until the next call or Reset().
+        /// @param filter Filter text (plain text or FilterQuery syntax); empty matches everything.
+        /// @param columns Columns of the snapshot's controller, for column predicates.
+        /// @param stopToken Checked every few thousand rows; once a stop is requested the scan is
+        ///        abandoned, the cache is Reset() and the (incomplete) result must be discarded.
+        /// @return The matching objects. Valid until the next call or Reset().
+        const std::vector<DataObject *> &Apply(const std::shared_ptr<const DataObjectContainer> &snapshot,
+            std::string_view filter,
+            const std::vector<DataObjectColumn> &columns,
+            std::stop_token stopToken = {});
+
+        /// @brief Get the query compiled from the last filter text (e.g. to show its error).
+        const FilterQuery &GetQuery() const noexcept
+        {
+            return m_query;
+        }
+
+        /// @brief Forget the cached result and release the snapshot.
+        void Reset() noexcept;
+
+    private:
+        std::shared_ptr<const DataObjectContainer> m_snapshot; ///< Snapshot m_matches points into.
+        const std::vector<DataObjectColumn> *m_pColumns{nullptr}; ///< Columns m_query was compiled for.
+        std::string m_filter;                                  ///< Filter m_matches was computed for.
+        FilterQuery m_query;                                   ///< m_filter, compiled.
+        std::vector<DataObject *> m_matches;                   ///< Objects of m_snapshot matching m_query.
+    };
+} // namespace pserv
@@ -0,0 +1,134 @@
+#include "precomp.h"
+#include <core/object_pool.h>
+
+namespace pserv
+{
+    /// All pools that currently exist, for GetAllStatistics().
+    static std::mutex g_poolRegistryMutex;
+    static std::vector<const ObjectPool *> &GetPoolRegistry()
+    {
+        static std::vector<const ObjectPool *> registry;
+        return registry;
+    }
+
+    static size_t AlignUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    ObjectPool::ObjectPool(std::string typeName, size_t objectSize, size_t objectAlignment, size_t objectsPerSlab)
+        : m_typeName{std::move(typeName)}
+        , m_objectSize{objectSize}
+        , m_slotSize{AlignUp(std::max(objectSize, sizeof(FreeSlot)), std::max(objectAlignment, alignof(FreeSlot)))}
+        , m_slotAlignment{std::max(objectAlignment, alignof(FreeSlot))}
+        , m_objectsPerSlab{std::max<size_t>(objectsPerSlab, 1)}
+    {
+        std::lock_guard<std::mutex> lock{g_poolRegistryMutex};
+        GetPoolRegistry().push_back(this);
+    }
+
+    ObjectPool::~ObjectPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{g_poolRegistryMutex};
+            std::erase(GetPoolRegistry(), this);
+        }
+
+        // Objects still alive at exit keep their slab (they would otherwise point into freed memory)
+        if (m_live == 0)
+        {
+            for (const auto pSlab : m_slabs)
+            {
+                ::operator delete(pSlab, std::align_val_t{m_slotAlignment});
+            }
+        }
+    }
+
+    void *ObjectPool::Allocate()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        void *pSlot;
+        if (m_pFreeList != nullptr)
+        {
+            pSlot = m_pFreeList;
+            m_pFreeList = m_pFreeList->pNext;
+            ++m_recycled;
+        }
+        else
+        {
+            if (m_pNextFresh == m_pSlabEnd)
+            {
+                AllocateSlab();
+            }
+            pSlot = m_pNextFresh;
+            m_pNextFresh += m_slotSize;
+        }
+
+        ++m_allocations;
+        m_peak = std::max(m_peak, ++m_live);
+        return pSlot;
+    }
+
+    void ObjectPool::Deallocate(void *pSlot) noexcept
+    {
+        if (pSlot == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        const auto pFree = static_cast<FreeSlot *>(pSlot);
+        pFree->pNext = m_pFreeList;
+        m_pFreeList = pFree;
+        --m_live;
+    }
+
+    void ObjectPool::AllocateSlab()
+    {
+        const size_t slabSize = m_slotSize * m_objectsPerSlab;
+        const auto pSlab = static_cast<std::byte *>(::operator new(slabSize, std::align_val_t{m_slotAlignment}));
+        m_slabs.push_back(pSlab);
+        m_pNextFresh = pSlab;
+        m_pSlabEnd = pSlab + slabSize;
+    }
+
+    ObjectPoolStatistics ObjectPool::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ObjectPoolStatistics statistics;
+        statistics.TypeName = m_typeName;
+        statistics.ObjectSize = m_objectSize;
+        statistics.Live = m_live;
+        statistics.Peak = m_peak;
+        statistics.Capacity = m_slabs.size() * m_objectsPerSlab;
+        statistics.Allocations = m_allocations;
+        statistics.Recycled = m_recycled;
+        return statistics;
+    }
+
+    std::vector<ObjectPoolStatistics> ObjectPool::GetAllStatistics()
+    {
+        std::lock_guard<std::mutex> lock{g_poolRegistryMutex};
+        std::vector<ObjectPoolStatistics> result;
+        result.reserve(GetPoolRegistry().size());
+        for (const auto pPool : GetPoolRegistry())
+        {
+            result.push_back(pPool->GetStatistics());
+        }
+        return result;
+    }
+
+    void ObjectPool::LogStatistics()
+    {
+        for (const auto &statistics : GetAllStatistics())
+        {
+            spdlog::info("Object pool {}: {} live, {} peak, {} slots of {} bytes, {} allocations, {} recycled",
+                statistics.TypeName,
+                statistics.Live,
+                statistics.Peak,
+                statistics.Capacity,
+                statistics.ObjectSize,
+                statistics.Allocations,
+                statistics.Recycled);
+        }
+    }
+} // namespace pserv
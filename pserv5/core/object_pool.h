@@ -0,0 +1,139 @@
+/// @file object_pool.h
+/// @brief Per-type slab pools for DataObject subclasses.
+///
+/// Every refresh cycle creates objects for new rows and releases the ones
+/// that disappeared. With high churn (processes, network connections) that is
+/// constant general-heap traffic. Classes deriving from PooledObject<T>
+/// instead take their memory from a pool of fixed-size slots carved out of
+/// large slabs; released slots go onto a free list and are handed out again
+/// by the next refresh.
+#pragma once
+
+namespace pserv
+{
+    /// @brief Counters of one ObjectPool.
+    struct ObjectPoolStatistics final
+    {
+        std::string TypeName;   ///< Type of the pooled objects.
+        size_t ObjectSize{0};   ///< Slot size in bytes.
+        size_t Live{0};         ///< Objects currently allocated.
+        size_t Peak{0};         ///< Highest Live value so far.
+        size_t Capacity{0};     ///< Slots in all slabs (allocated and free).
+        uint64_t Allocations{0}; ///< Total number of allocations.
+        uint64_t Recycled{0};   ///< Allocations served from the free list.
+    };
+
+    /// @brief Thread-safe pool of fixed-size memory slots.
+    ///
+    /// Slots are carved out of slabs of @c objectsPerSlab slots. Freed slots are
+    /// kept on an intrusive free list and reused before any new slot is taken;
+    /// slabs are only returned to the heap when the pool is destroyed.
+    class ObjectPool final
+    {
+    public:
+        /// @brief Default number of slots per slab.
+        static constexpr size_t DEFAULT_OBJECTS_PER_SLAB = 256;
+
+        /// @brief Create a pool and register it for GetAllStatistics().
+        /// @param typeName Name reported in the statistics.
+        /// @param objectSize Size of one object in bytes.
+        /// @param objectAlignment Required alignment of one object.
+        /// @param objectsPerSlab Number of slots allocated at a time.
+        ObjectPool(std::string typeName, size_t objectSize, size_t objectAlignment, size_t objectsPerSlab = DEFAULT_OBJECTS_PER_SLAB);
+        ~ObjectPool();
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+        /// @brief Allocate one slot (at least objectSize bytes, suitably aligned).
+        /// @throws std::bad_alloc if a new slab cannot be allocated.
+        void *Allocate();
+
+        /// @brief Return a slot obtained from Allocate() to the free list.
+        void Deallocate(void *pSlot) noexcept;
+
+        /// @brief Get a consistent copy of the counters.
+        ObjectPoolStatistics GetStatistics() const;
+
+        /// @brief Get the counters of all pools that exist.
+        static std::vector<ObjectPoolStatistics> GetAllStatistics();
+
+        /// @brief Write the counters of all pools to the log.
+        static void LogStatistics();
+
+    private:
+        struct FreeSlot
+        {
+            FreeSlot *pNext;
+        };
+
+        void AllocateSlab();
+
+        const std::string m_typeName;
+        const size_t m_objectSize;
+        const size_t m_slotSize;
+        const size_t m_slotAlignment;
+        const size_t m_objectsPerSlab;
+
+        mutable std::mutex m_mutex;       ///< Guards everything below.
+        std::vector<void *> m_slabs;      ///< All slabs, freed in the destructor.
+        FreeSlot *m_pFreeList{nullptr};   ///< Released slots.
+        std::byte *m_pNextFresh{nullptr}; ///< Next never-used slot in the newest slab.
+        std::byte *m_pSlabEnd{nullptr};   ///< End of the newest slab.
+        size_t m_live{0};
+        size_t m_peak{0};
+        uint64_t m_allocations{0};
+        uint64_t m_recycled{0};
+    };
+
+    /// @brief Mixin that makes a class allocate its instances from a per-type ObjectPool.
+    /// @tparam T The class deriving from this mixin (CRTP).
+    ///
+    /// Provides class-specific operator new/delete, so `DBG_NEW T{...}` in the
+    /// managers and `delete this` in RefCountImpl::Release() go through the pool
+    /// without changes at the call sites. T must have a virtual destructor if it
+    /// is deleted through a base pointer, so that the sized delete sees sizeof(T).
+    /// Objects of a different size (e.g. classes derived from T) use the global heap.
+    template <typename T> class PooledObject
+    {
+    public:
+        /// @brief The pool shared by all instances of T.
+        static ObjectPool &GetPool()
+        {
+            static ObjectPool pool{typeid(T).name(), sizeof(T), alignof(T)};
+            return pool;
+        }
+
+        static void *operator new(size_t size)
+        {
+            if (size != sizeof(T))
+                return ::operator new(size);
+            return GetPool().Allocate();
+        }
+
+        static void operator delete(void *pObject, size_t size) noexcept
+        {
+            if (pObject == nullptr)
+                return;
+            if (size != sizeof(T))
+            {
+                ::operator delete(pObject);
+                return;
+            }
+            GetPool().Deallocate(pObject);
+        }
+
+#ifdef _DEBUG
+        // Overloads matching DBG_NEW; the pool does its own bookkeeping instead of the CRT debug heap
+        static void *operator new(size_t size, int, const char *, int)
+        {
+            return operator new(size);
+        }
+
+        static void operator delete(void *pObject, int, const char *, int) noexcept
+        {
+            operator delete(pObject, sizeof(T));
+        }
+#endif
+    };
+} // namespace pserv
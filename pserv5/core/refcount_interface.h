@@ -115,6 +115,12 @@ namespace pserv
         {
         }
 
+        /// @brief Check if anyone besides the current owner holds a reference.
+        bool IsShared() const noexcept
+        {
+            return m_refCount.load(std::memory_order_acquire) > 1;
+        }
+
     private:
         mutable std::atomic<int> m_refCount; ///< Thread-safe reference counter.
     };
@@ -0,0 +1,66 @@
+#include "precomp.h"
+#include <core/secondary_index.h>
+#include <utils/string_utils.h>
+
+namespace pserv
+{
+    StableKey SecondaryKey::ForUser(std::string_view user)
+    {
+        return StableKey::FromString(utils::ToLower(user));
+    }
+
+    void SecondaryIndexMap::Update(DataObject *dataObject, const std::optional<StableKey> &key)
+    {
+        const auto it = m_keys.find(dataObject);
+        if (it != m_keys.end())
+        {
+            if (key && it->second == *key)
+                return;
+
+            RemoveFromGroup(dataObject, it->second);
+            if (!key)
+            {
+                m_keys.erase(it);
+                return;
+            }
+            it->second = *key;
+        }
+        else
+        {
+            if (!key)
+                return;
+            m_keys.emplace(dataObject, *key);
+        }
+        m_groups[*key].push_back(dataObject);
+    }
+
+    void SecondaryIndexMap::Erase(DataObject *dataObject)
+    {
+        const auto it = m_keys.find(dataObject);
+        if (it != m_keys.end())
+        {
+            RemoveFromGroup(dataObject, it->second);
+            m_keys.erase(it);
+        }
+    }
+
+    void SecondaryIndexMap::RemoveFromGroup(DataObject *dataObject, const StableKey &key)
+    {
+        const auto groupIt = m_groups.find(key);
+        if (groupIt == m_groups.end())
+            return;
+
+        // Groups are unordered, so swap-and-pop is fine
+        auto &group = groupIt->second;
+        const auto objectIt = std::find(group.begin(), group.end(), dataObject);
+        if (objectIt != group.end())
+        {
+            *objectIt = group.back();
+            group.pop_back();
+        }
+        if (group.empty())
+        {
+            m_groups.erase(groupIt);
+        }
+    }
+} // namespace pserv
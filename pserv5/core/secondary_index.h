@@ -0,0 +1,90 @@
+/// @file secondary_index.h
+/// @brief Secondary (non-unique) indexes of a DataObjectContainer.
+///
+/// Several views relate their rows by process ID, user or service type.
+/// Models declare the keys they can be found under via
+/// DataObject::GetSecondaryKey(); the container keeps one SecondaryIndexMap
+/// per SecondaryIndex up to date, so "all modules of PID X" is a single hash
+/// lookup instead of a scan over the whole container.
+#pragma once
+
+#include <core/stable_key.h>
+
+namespace pserv
+{
+    class DataObject;
+
+    /// @brief The secondary indexes every DataObjectContainer maintains.
+    enum class SecondaryIndex
+    {
+        ProcessId = 0, ///< Process the object belongs to (processes, modules, windows, connections, services).
+        User,          ///< Owning user or service account (case-insensitive).
+        ServiceType,   ///< SERVICE_* type bits of a service or driver.
+        Count          ///< Number of indexes (not an index).
+    };
+
+    /// @brief Key builders, so that models and queries agree on the key of a value.
+    struct SecondaryKey final
+    {
+        /// @brief Key for SecondaryIndex::ProcessId.
+        static constexpr StableKey ForProcessId(uint32_t processId) noexcept
+        {
+            return StableKey::FromInteger(processId);
+        }
+
+        /// @brief Key for SecondaryIndex::User; "DOMAIN\\User" and "domain\\user" share a key.
+        static StableKey ForUser(std::string_view user);
+
+        /// @brief Key for SecondaryIndex::ServiceType.
+        static constexpr StableKey ForServiceType(uint32_t serviceType) noexcept
+        {
+            return StableKey::FromInteger(serviceType);
+        }
+    };
+
+    /// @brief Hash multimap from a secondary key to the objects carrying it.
+    ///
+    /// Remembers the key each object was filed under, so objects can be moved
+    /// to their new group when the key changes. Like StableKeyIndex it does not
+    /// own the objects; the order of objects within a group is unspecified.
+    class SecondaryIndexMap final
+    {
+    public:
+        /// @brief File an object under a key, moving it out of its previous group.
+        /// @param dataObject The object.
+        /// @param key The object's current key; std::nullopt removes it from the index.
+        void Update(DataObject *dataObject, const std::optional<StableKey> &key);
+
+        /// @brief Remove an object from the index (no-op if it is not indexed).
+        void Erase(DataObject *dataObject);
+
+        /// @brief Get all objects filed under a key.
+        /// @return The group, or an empty span. Invalidated by the next modification.
+        std::span<DataObject *const> Find(const StableKey &key) const noexcept
+        {
+            const auto it = m_groups.find(key);
+            if (it == m_groups.end())
+                return {};
+            return it->second;
+        }
+
+        /// @brief Remove all entries.
+        void Clear() noexcept
+        {
+            m_groups.clear();
+            m_keys.clear();
+        }
+
+        /// @brief Number of distinct keys.
+        size_t GetGroupCount() const noexcept
+        {
+            return m_groups.size();
+        }
+
+    private:
+        void RemoveFromGroup(DataObject *dataObject, const StableKey &key);
+
+        std::unordered_map<StableKey, std::vector<DataObject *>, StableKeyHash> m_groups; ///< Key -> objects.
+        std::unordered_map<const DataObject *, StableKey> m_keys;                         ///< Object -> key it is filed under.
+    };
+} // namespace pserv
@@ -0,0 +1,154 @@
+#include "precomp.h"
+#include <core/sort_key.h>
+#include <utils/string_utils.h>
+
+namespace pserv
+{
+    SortKey SortKey::Create(const DataObject &dataObject, int columnIndex, ColumnDataType dataType)
+    {
+        SortKey key;
+        PropertyValue value = dataObject.GetTypedProperty(columnIndex);
+
+        if (IsNumeric(dataType))
+        {
+            key.Number = EncodeNumber(value);
+        }
+        else if (std::holds_alternative<std::string>(value))
+        {
+            key.Collation = CreateCollationKey(std::get<std::string>(value));
+        }
+        else
+        {
+            // Time columns etc. sort by their display text
+            key.Collation = CreateCollationKey(dataObject.GetProperty(columnIndex));
+        }
+        return key;
+    }
+
+    uint64_t SortKey::EncodeNumber(const PropertyValue &value) noexcept
+    {
+        if (std::holds_alternative<uint64_t>(value))
+        {
+            return std::get<uint64_t>(value);
+        }
+        if (std::holds_alternative<int64_t>(value))
+        {
+            return static_cast<uint64_t>(std::get<int64_t>(value)) ^ (1ULL << 63);
+        }
+        return 0;
+    }
+
+    std::string SortKey::CreateCollationKey(std::string_view utf8)
+    {
+        if (utf8.empty())
+            return {};
+
+        // Same semantics as the CompareStringEx(LINGUISTIC_IGNORECASE) comparison this replaces,
+        // but computed once per object: the resulting byte strings compare with memcmp.
+        const std::wstring wide = utils::Utf8ToWide(utf8);
+        const int size = LCMapStringEx(LOCALE_NAME_USER_DEFAULT,
+            LCMAP_SORTKEY | LINGUISTIC_IGNORECASE,
+            wide.c_str(), static_cast<int>(wide.length()),
+            nullptr, 0,
+            nullptr, nullptr, 0);
+        if (size > 0)
+        {
+            std::string key(static_cast<size_t>(size), '\0');
+            // For LCMAP_SORTKEY the destination is a byte buffer and the size is in bytes
+            if (LCMapStringEx(LOCALE_NAME_USER_DEFAULT,
+                    LCMAP_SORTKEY | LINGUISTIC_IGNORECASE,
+                    wide.c_str(), static_cast<int>(wide.length()),
+                    reinterpret_cast<LPWSTR>(key.data()), size,
+                    nullptr, nullptr, 0) == size)
+            {
+                return key;
+            }
+        }
+        return CaseFold(utf8);
+    }
+
+    std::string SortKey::CaseFold(std::string_view utf8)
+    {
+        return utils::ToLower(utf8);
+    }
+
+    static std::string_view TrimSpaces(std::string_view text)
+    {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+            text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    static int FindSortColumn(std::string_view name, const std::vector<DataObjectColumn> &columns)
+    {
+        const auto lowerName = utils::ToLower(name);
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            if (utils::ToLower(columns[i].DisplayName) == lowerName || utils::ToLower(columns[i].BindingName) == lowerName)
+            {
+                return static_cast<int>(i);
+            }
+        }
+
+        int index = -1;
+        const auto result = std::from_chars(name.data(), name.data() + name.size(), index);
+        if (result.ec == std::errc{} && result.ptr == name.data() + name.size() && index >= 0 && index < static_cast<int>(columns.size()))
+        {
+            return index;
+        }
+        return -1;
+    }
+
+    std::vector<SortSpec> SortSpec::ParseList(std::string_view text, const std::vector<DataObjectColumn> &columns, std::vector<std::string> *unknownColumns)
+    {
+        std::vector<SortSpec> sortSpecs;
+        while (!text.empty())
+        {
+            const auto comma = text.find(',');
+            auto token = TrimSpaces(text.substr(0, comma));
+            text = (comma == std::string_view::npos) ? std::string_view{} : text.substr(comma + 1);
+
+            bool ascending = true;
+            if (!token.empty() && (token.front() == '-' || token.front() == '+'))
+            {
+                ascending = (token.front() == '+');
+                token = TrimSpaces(token.substr(1));
+            }
+            if (token.empty())
+                continue;
+
+            const int columnIndex = FindSortColumn(token, columns);
+            if (columnIndex < 0)
+            {
+                if (unknownColumns)
+                {
+                    unknownColumns->emplace_back(token);
+                }
+                continue;
+            }
+
+            // A column can only contribute one key; the first occurrence wins
+            if (std::ranges::none_of(sortSpecs, [columnIndex](const SortSpec &spec) { return spec.ColumnIndex == columnIndex; }))
+            {
+                sortSpecs.push_back(SortSpec{columnIndex, ascending});
+            }
+        }
+        return sortSpecs;
+    }
+
+    std::string SortSpec::FormatList(const std::vector<SortSpec> &sortSpecs)
+    {
+        std::string result;
+        for (const auto &spec : sortSpecs)
+        {
+            if (!result.empty())
+                result += ',';
+            if (!spec.Ascending)
+                result += '-';
+            result += std::to_string(spec.ColumnIndex);
+        }
+        return result;
+    }
+} // namespace pserv
@@ -0,0 +1,79 @@
+/// @file sort_key.h
+/// @brief Precomputed sort keys for column sorting.
+///
+/// Sorting compares every object O(log n) times. Rather than fetching and
+/// transcoding property values inside the comparator, DataObjectContainer
+/// extracts one SortKey per object and sort column up front and sorts the
+/// objects by comparing those keys only.
+#pragma once
+
+#include <core/data_object.h>
+#include <core/data_object_column.h>
+
+namespace pserv
+{
+    /// @brief One key of a (possibly multi-column) sort order.
+    struct SortSpec final
+    {
+        int ColumnIndex{-1};  ///< Column (property) index.
+        bool Ascending{true}; ///< Sort direction for this column.
+
+        bool operator==(const SortSpec &other) const noexcept = default;
+
+        /// @brief Parse a comma-separated sort list such as "Name,-Working Set" or "3,-1".
+        /// A leading '-' sorts that column descending, an optional '+' ascending. Columns are
+        /// matched by display name or binding name (case-insensitive) or by numeric index.
+        /// @param text The sort list.
+        /// @param columns The columns of the controller being sorted.
+        /// @param unknownColumns If not null, receives the tokens that did not match any column.
+        /// @return The parsed keys in priority order; unknown and repeated columns are skipped.
+        static std::vector<SortSpec> ParseList(
+            std::string_view text, const std::vector<DataObjectColumn> &columns, std::vector<std::string> *unknownColumns = nullptr);
+
+        /// @brief Format sort keys as a comma-separated index list (e.g. "3,-1") for the config file.
+        static std::string FormatList(const std::vector<SortSpec> &sortSpecs);
+    };
+
+    /// @brief Directly comparable sort key for one column value of one object.
+    ///
+    /// Numeric columns store an order-preserving 64-bit encoding in Number;
+    /// text columns store a binary, case-folded collation key in Collation that
+    /// compares bytewise. Keys built for the same column compare consistently.
+    struct SortKey final
+    {
+        uint64_t Number{0};    ///< Order-preserving encoding of a numeric value.
+        std::string Collation; ///< Binary collation key of a text value.
+
+        /// @brief Extract the sort key for a column of a data object.
+        /// @param dataObject Object to read the value from.
+        /// @param columnIndex Column (property) index.
+        /// @param dataType Column data type; numeric types produce Number keys.
+        static SortKey Create(const DataObject &dataObject, int columnIndex, ColumnDataType dataType);
+
+        /// @brief Check if a column type sorts numerically.
+        static bool IsNumeric(ColumnDataType dataType) noexcept
+        {
+            return dataType == ColumnDataType::Integer || dataType == ColumnDataType::UnsignedInteger || dataType == ColumnDataType::Size;
+        }
+
+        /// @brief Map a typed value onto uint64_t so that unsigned comparison matches numeric order.
+        /// Signed values are offset by flipping the sign bit; non-numeric values map to 0.
+        static uint64_t EncodeNumber(const PropertyValue &value) noexcept;
+
+        /// @brief Build a case-insensitive, locale-aware collation key for UTF-8 text.
+        /// Uses LCMapStringEx(LCMAP_SORTKEY); falls back to CaseFold() if that fails.
+        static std::string CreateCollationKey(std::string_view utf8);
+
+        /// @brief Portable collation fallback: the text with ASCII letters lowercased.
+        static std::string CaseFold(std::string_view utf8);
+
+        /// @brief Three-way comparison of two keys.
+        /// @return <0, 0 or >0 like strcmp.
+        int Compare(const SortKey &other) const noexcept
+        {
+            if (Number != other.Number)
+                return Number < other.Number ? -1 : 1;
+            return Collation.compare(other.Collation);
+        }
+    };
+} // namespace pserv
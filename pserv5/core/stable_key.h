@@ -0,0 +1,83 @@
+/// @file stable_key.h
+/// @brief Compact 128-bit identity keys for DataObjects.
+///
+/// A StableKey is the binary counterpart of DataObject::GetStableID(): each
+/// model composes it from its native fields (PID, HWND, protocol/port, ...)
+/// so that refresh cycles can look objects up without building and hashing
+/// strings. The textual stable ID is still available for export and display.
+#pragma once
+
+namespace pserv
+{
+    /// @brief 128-bit stable identity of a DataObject.
+    ///
+    /// Models with purely numeric identities store them verbatim (e.g. a PID
+    /// in Low); models identified by text fold the text into the key via
+    /// HashString(). Two objects in the same container must never share a key.
+    struct StableKey final
+    {
+        uint64_t High{0}; ///< Upper 64 bits (e.g. owning PID, protocol/port).
+        uint64_t Low{0};  ///< Lower 64 bits (e.g. PID, HWND, name hash).
+
+        constexpr bool operator==(const StableKey &other) const noexcept = default;
+
+        /// @brief Build a key from a single integer identity (PID, handle value, ...).
+        static constexpr StableKey FromInteger(uint64_t value) noexcept
+        {
+            return StableKey{0, value};
+        }
+
+        /// @brief Build a key from two integer components.
+        static constexpr StableKey FromPair(uint64_t high, uint64_t low) noexcept
+        {
+            return StableKey{high, low};
+        }
+
+        /// @brief Build a key from a textual identity (service name, registry path, ...).
+        /// Uses two independent 64-bit hashes so accidental collisions are negligible.
+        static constexpr StableKey FromString(std::string_view text) noexcept
+        {
+            return StableKey{HashString(text, 0x84222325cbf29ce4ULL), HashString(text)};
+        }
+
+        /// @brief 64-bit FNV-1a hash of a string, with a final avalanche step.
+        /// @param text Text to hash (hashed byte-wise, i.e. case-sensitive).
+        /// @param seed Initial hash state; defaults to the FNV-1a offset basis.
+        static constexpr uint64_t HashString(std::string_view text, uint64_t seed = 0xcbf29ce484222325ULL) noexcept
+        {
+            uint64_t hash = seed;
+            for (const char c : text)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 0x100000001b3ULL;
+            }
+            return Mix(hash);
+        }
+
+        /// @brief Finalizer (splitmix64) used to spread small integer keys over the hash space.
+        static constexpr uint64_t Mix(uint64_t value) noexcept
+        {
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ULL;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebULL;
+            value ^= value >> 31;
+            return value;
+        }
+
+        /// @brief Hash value for use in hash tables.
+        constexpr size_t Hash() const noexcept
+        {
+            return static_cast<size_t>(Mix(Low ^ Mix(High)));
+        }
+    };
+
+    /// @brief Hash functor so StableKey can be used with std::unordered_* containers.
+    struct StableKeyHash final
+    {
+        size_t operator()(const StableKey &key) const noexcept
+        {
+            return key.Hash();
+        }
+    };
+} // namespace pserv
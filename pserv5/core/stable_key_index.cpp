@@ -0,0 +1,108 @@
+#include "precomp.h"
+#include <core/stable_key_index.h>
+
+namespace pserv
+{
+    /// Minimum slot count once the index holds anything.
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    void StableKeyIndex::Insert(const StableKey &key, DataObject *value)
+    {
+        assert(value != nullptr);
+
+        // Keep the load factor at or below 50% so probe sequences stay short
+        if ((m_size + 1) * 2 > m_slots.size())
+        {
+            Rehash(std::max(MIN_CAPACITY, m_slots.size() * 2));
+        }
+
+        for (size_t index = SlotFor(key);; index = (index + 1) & m_mask)
+        {
+            Slot &slot = m_slots[index];
+            if (slot.Value == nullptr)
+            {
+                slot.Key = key;
+                slot.Value = value;
+                ++m_size;
+                return;
+            }
+            if (slot.Key == key)
+            {
+                slot.Value = value;
+                return;
+            }
+        }
+    }
+
+    bool StableKeyIndex::Erase(const StableKey &key) noexcept
+    {
+        if (m_slots.empty())
+            return false;
+
+        size_t index = SlotFor(key);
+        for (;; index = (index + 1) & m_mask)
+        {
+            const Slot &slot = m_slots[index];
+            if (slot.Value == nullptr)
+                return false;
+            if (slot.Key == key)
+                break;
+        }
+
+        // Backward-shift deletion: move later members of the probe chain into the hole
+        // so that no tombstones are needed and lookups can stop at the first empty slot.
+        size_t hole = index;
+        for (size_t next = (hole + 1) & m_mask;; next = (next + 1) & m_mask)
+        {
+            Slot &candidate = m_slots[next];
+            if (candidate.Value == nullptr)
+                break;
+
+            // Distance of the candidate from its home slot vs. distance of the hole from it
+            const size_t home = SlotFor(candidate.Key);
+            if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+            {
+                m_slots[hole] = candidate;
+                hole = next;
+            }
+        }
+        m_slots[hole] = Slot{};
+        --m_size;
+        return true;
+    }
+
+    void StableKeyIndex::Clear() noexcept
+    {
+        std::fill(m_slots.begin(), m_slots.end(), Slot{});
+        m_size = 0;
+    }
+
+    void StableKeyIndex::Reserve(size_t count)
+    {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity < count * 2)
+        {
+            capacity *= 2;
+        }
+        if (capacity > m_slots.size())
+        {
+            Rehash(capacity);
+        }
+    }
+
+    void StableKeyIndex::Rehash(size_t newCapacity)
+    {
+        std::vector<Slot> oldSlots(newCapacity);
+        oldSlots.swap(m_slots);
+        m_mask = newCapacity - 1;
+        m_size = 0;
+
+        for (const Slot &slot : oldSlots)
+        {
+            if (slot.Value != nullptr)
+            {
+                Insert(slot.Key, slot.Value);
+            }
+        }
+    }
+} // namespace pserv
@@ -0,0 +1,101 @@
+/// @file stable_key_index.h
+/// @brief Flat open-addressing hash index from StableKey to DataObject.
+///
+/// Used by DataObjectContainer for O(1) lookups during refresh cycles. All
+/// entries live in one contiguous slot array (linear probing, backward-shift
+/// deletion), so lookups touch one or two cache lines and never allocate.
+#pragma once
+
+#include <core/stable_key.h>
+
+namespace pserv
+{
+    class DataObject;
+
+    /// @brief Open-addressing hash map StableKey -> DataObject*.
+    ///
+    /// The index does not own the objects it points to; DataObjectContainer
+    /// manages their reference counts. nullptr is used as the empty-slot marker
+    /// and therefore cannot be stored as a value.
+    class StableKeyIndex final
+    {
+    public:
+        StableKeyIndex() = default;
+        StableKeyIndex(const StableKeyIndex &) = default;
+        StableKeyIndex &operator=(const StableKeyIndex &) = default;
+
+        StableKeyIndex(StableKeyIndex &&moveSrc) noexcept
+            : m_slots{std::move(moveSrc.m_slots)}
+            , m_mask{std::exchange(moveSrc.m_mask, 0)}
+            , m_size{std::exchange(moveSrc.m_size, 0)}
+        {
+            moveSrc.m_slots.clear();
+        }
+
+        StableKeyIndex &operator=(StableKeyIndex &&moveSrc) noexcept
+        {
+            if (this != &moveSrc)
+            {
+                m_slots = std::move(moveSrc.m_slots);
+                m_mask = std::exchange(moveSrc.m_mask, 0);
+                m_size = std::exchange(moveSrc.m_size, 0);
+                moveSrc.m_slots.clear();
+            }
+            return *this;
+        }
+
+        /// @brief Find the object stored under a key.
+        /// @return The object, or nullptr if the key is not present.
+        DataObject *Find(const StableKey &key) const noexcept
+        {
+            if (m_slots.empty())
+                return nullptr;
+
+            for (size_t index = SlotFor(key);; index = (index + 1) & m_mask)
+            {
+                const Slot &slot = m_slots[index];
+                if (slot.Value == nullptr)
+                    return nullptr;
+                if (slot.Key == key)
+                    return slot.Value;
+            }
+        }
+
+        /// @brief Insert or replace the object stored under a key.
+        void Insert(const StableKey &key, DataObject *value);
+
+        /// @brief Remove a key from the index.
+        /// @return true if the key was present.
+        bool Erase(const StableKey &key) noexcept;
+
+        /// @brief Remove all entries (keeps the allocated slot array).
+        void Clear() noexcept;
+
+        /// @brief Ensure capacity for at least @p count entries without rehashing.
+        void Reserve(size_t count);
+
+        /// @brief Number of stored entries.
+        size_t GetSize() const noexcept
+        {
+            return m_size;
+        }
+
+    private:
+        struct Slot
+        {
+            StableKey Key;
+            DataObject *Value{nullptr};
+        };
+
+        size_t SlotFor(const StableKey &key) const noexcept
+        {
+            return key.Hash() & m_mask;
+        }
+
+        void Rehash(size_t newCapacity);
+
+        std::vector<Slot> m_slots; ///< Power-of-two sized slot array.
+        size_t m_mask{0};          ///< m_slots.size() - 1.
+        size_t m_size{0};          ///< Number of occupied slots.
+    };
+} // namespace pserv
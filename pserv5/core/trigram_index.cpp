@@ -0,0 +1,273 @@
+#include "precomp.h"
+#include <core/data_object.h>
+#include <core/trigram_index.h>
+
+namespace pserv
+{
+    /// Dead entries always tolerated before Compact(); above this, up to a quarter of the live ones.
+    static constexpr size_t MIN_DEAD_ENTRIES_FOR_COMPACTION = 1024;
+
+    /// The index only answers if the shortest posting list holds at most 1/N of the objects:
+    /// verifying most of the rows from an index costs more than scanning them in order.
+    static constexpr size_t MIN_SELECTIVITY = 4;
+
+    static inline uint32_t MakeTrigram(const char *text) noexcept
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8) |
+               static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+    }
+
+    /// Only ASCII trigrams within one field are indexed: fields are '\n'-separated, and
+    /// needles with non-ASCII characters are matched with Unicode case folding instead.
+    static inline bool IsIndexedByte(char c) noexcept
+    {
+        return c != '\n' && static_cast<unsigned char>(c) < 0x80;
+    }
+
+    void TrigramIndex::Update(const DataObject *dataObject)
+    {
+        const std::string &text = dataObject->GetSearchText();
+        const size_t textHash = std::hash<std::string_view>{}(text);
+
+        const auto it = m_ids.find(dataObject);
+        if (it != m_ids.end())
+        {
+            if (m_entries[it->second].TextHash == textHash)
+                return;
+
+            // Re-index under a new id, so posting lists stay append-only
+            m_entries[it->second].pObject = nullptr;
+            ++m_deadCount;
+            m_ids.erase(it);
+        }
+
+        const auto id = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back(Entry{dataObject, textHash});
+        m_ids.emplace(dataObject, id);
+        AddPostings(id, text);
+
+        if (NeedsCompaction())
+        {
+            Compact();
+        }
+    }
+
+    void TrigramIndex::Erase(const DataObject *dataObject)
+    {
+        const auto it = m_ids.find(dataObject);
+        if (it == m_ids.end())
+            return;
+
+        m_entries[it->second].pObject = nullptr;
+        ++m_deadCount;
+        m_ids.erase(it);
+        if (NeedsCompaction())
+        {
+            Compact();
+        }
+    }
+
+    void TrigramIndex::Clear() noexcept
+    {
+        m_ids.clear();
+        m_entries.clear();
+        m_postings.clear();
+        m_postingCount = 0;
+        m_deadCount = 0;
+    }
+
+    bool TrigramIndex::NeedsCompaction() const noexcept
+    {
+        return m_deadCount > std::max(MIN_DEAD_ENTRIES_FOR_COMPACTION, m_ids.size() / 4);
+    }
+
+    void TrigramIndex::AddPostings(uint32_t id, std::string_view text)
+    {
+        m_trigrams.clear();
+        for (size_t i = 0; i + 3 <= text.size(); ++i)
+        {
+            if (!IsIndexedByte(text[i + 2]))
+            {
+                i += 2; // no trigram can span this byte
+                continue;
+            }
+            if (IsIndexedByte(text[i]) && IsIndexedByte(text[i + 1]))
+            {
+                m_trigrams.push_back(MakeTrigram(text.data() + i));
+            }
+        }
+        std::ranges::sort(m_trigrams);
+        const auto duplicates = std::ranges::unique(m_trigrams);
+        m_trigrams.erase(duplicates.begin(), duplicates.end());
+
+        // Ids are handed out in increasing order, so appending keeps every list sorted
+        for (const auto trigram : m_trigrams)
+        {
+            m_postings[trigram].push_back(id);
+        }
+        m_postingCount += m_trigrams.size();
+    }
+
+    void TrigramIndex::Compact()
+    {
+        // Renumber the live entries in their current order; the mapping is monotonic,
+        // so the posting lists only need to be filtered and renumbered, not re-sorted.
+        constexpr uint32_t DEAD = UINT32_MAX;
+        std::vector<uint32_t> newIds(m_entries.size(), DEAD);
+        std::vector<Entry> entries;
+        entries.reserve(m_ids.size());
+        for (size_t id = 0; id < m_entries.size(); ++id)
+        {
+            if (m_entries[id].pObject != nullptr)
+            {
+                newIds[id] = static_cast<uint32_t>(entries.size());
+                m_ids[m_entries[id].pObject] = newIds[id];
+                entries.push_back(m_entries[id]);
+            }
+        }
+        m_entries.swap(entries);
+        m_deadCount = 0;
+        ++m_compactionCount;
+
+        m_postingCount = 0;
+        for (auto it = m_postings.begin(); it != m_postings.end();)
+        {
+            auto &postings = it->second;
+            auto writeIt = postings.begin();
+            for (const auto id : postings)
+            {
+                if (newIds[id] != DEAD)
+                {
+                    *writeIt++ = newIds[id];
+                }
+            }
+            postings.erase(writeIt, postings.end());
+            if (postings.empty())
+            {
+                it = m_postings.erase(it);
+                continue;
+            }
+            postings.shrink_to_fit();
+            m_postingCount += postings.size();
+            ++it;
+        }
+    }
+
+    bool TrigramIndex::FindCandidates(
+        std::span<const std::string_view> needles, std::span<DataObject *const> objects, std::vector<DataObject *> &candidates) const
+    {
+        std::vector<const std::vector<uint32_t> *> lists;
+        bool bNoMatch = false;
+        for (const auto needle : needles)
+        {
+            if (needle.size() < MIN_NEEDLE_LENGTH || !std::ranges::all_of(needle, IsIndexedByte))
+                continue;
+
+            std::string folded{needle};
+            for (char &c : folded)
+            {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            for (size_t i = 0; i + 3 <= folded.size(); ++i)
+            {
+                const auto it = m_postings.find(MakeTrigram(folded.data() + i));
+                if (it == m_postings.end())
+                {
+                    // No object contains this trigram, so none can contain the needle
+                    bNoMatch = true;
+                    break;
+                }
+                lists.push_back(&it->second);
+            }
+            if (bNoMatch)
+                break;
+        }
+        if (bNoMatch)
+        {
+            candidates.clear();
+            return true;
+        }
+        if (lists.empty())
+            return false;
+
+        // Intersect starting with the shortest list: the intermediate result never grows,
+        // and each longer list is only probed at the remaining ids.
+        std::ranges::sort(lists,
+            [](const std::vector<uint32_t> *a, const std::vector<uint32_t> *b)
+            { return a->size() != b->size() ? a->size() < b->size() : std::less<>{}(a, b); });
+        if (lists.front()->size() > objects.size() / MIN_SELECTIVITY)
+            return false;
+        const auto duplicates = std::ranges::unique(lists);
+        lists.erase(duplicates.begin(), duplicates.end());
+
+        candidates.clear();
+        std::vector<uint32_t> ids{*lists.front()};
+        for (size_t i = 1; i < lists.size() && !ids.empty(); ++i)
+        {
+            const auto &list = *lists[i];
+            auto listIt = list.begin();
+            auto writeIt = ids.begin();
+            for (const auto id : ids)
+            {
+                listIt = std::lower_bound(listIt, list.end(), id);
+                if (listIt == list.end())
+                    break;
+                if (*listIt == id)
+                {
+                    *writeIt++ = id;
+                }
+            }
+            ids.erase(writeIt, ids.end());
+        }
+
+        std::vector<const DataObject *> matches;
+        matches.reserve(ids.size());
+        for (const auto id : ids)
+        {
+            if (m_entries[id].pObject != nullptr)
+            {
+                matches.push_back(m_entries[id].pObject);
+            }
+        }
+        if (matches.empty())
+            return true;
+
+        // Restore the caller's order (e.g. the current sort) with a pass over the rows that
+        // only compares pointers and never touches the objects themselves
+        if (matches.size() == objects.size())
+        {
+            candidates.assign(objects.begin(), objects.end());
+            return true;
+        }
+        std::ranges::sort(matches);
+        candidates.reserve(matches.size());
+        for (auto *dataObject : objects)
+        {
+            if (std::ranges::binary_search(matches, dataObject))
+            {
+                candidates.push_back(dataObject);
+            }
+        }
+        return true;
+    }
+
+    TrigramIndexStatistics TrigramIndex::GetStatistics() const noexcept
+    {
+        // Node-based hash maps: one allocation per element (value plus next pointer and cached hash)
+        constexpr size_t NODE_OVERHEAD = 2 * sizeof(void *);
+
+        TrigramIndexStatistics statistics;
+        statistics.ObjectCount = m_ids.size();
+        statistics.TrigramCount = m_postings.size();
+        statistics.PostingCount = m_postingCount;
+        statistics.MemoryBytes = m_entries.capacity() * sizeof(Entry) +
+            m_ids.bucket_count() * sizeof(void *) + m_ids.size() * (sizeof(decltype(m_ids)::value_type) + NODE_OVERHEAD) +
+            m_postings.bucket_count() * sizeof(void *) + m_postings.size() * (sizeof(decltype(m_postings)::value_type) + NODE_OVERHEAD);
+        for (const auto &[trigram, postings] : m_postings)
+        {
+            statistics.MemoryBytes += postings.capacity() * sizeof(uint32_t);
+        }
+        return statistics;
+    }
+} // namespace pserv
@@ -0,0 +1,98 @@
+/// @file trigram_index.h
+/// @brief Trigram inverted index over the search text of a DataObjectContainer.
+///
+/// A filter scan runs a substring search over every row. For views with tens
+/// of thousands of rows (e.g. all modules of all processes) a TrigramIndex
+/// narrows this down first: it maps every three-byte sequence of the objects'
+/// search text (DataObject::GetSearchText()) to the sorted list of objects
+/// containing it. A needle of three or more characters can only occur in
+/// objects that contain all of its trigrams, so intersecting their posting
+/// lists yields a candidate set that is usually a small fraction of the rows.
+/// Candidates still have to be verified with the real filter.
+///
+/// The index is maintained incrementally from refresh changesets: objects
+/// whose search text did not change are skipped by comparing a hash of the
+/// text, and removed objects are only marked dead until enough of them have
+/// piled up to make a compaction worthwhile.
+#pragma once
+
+namespace pserv
+{
+    class DataObject;
+
+    /// @brief Size information of a TrigramIndex, for logging.
+    struct TrigramIndexStatistics final
+    {
+        size_t ObjectCount{0};  ///< Live indexed objects.
+        size_t TrigramCount{0}; ///< Distinct trigrams (posting lists).
+        size_t PostingCount{0}; ///< Entries in all posting lists, including those of dead objects.
+        size_t MemoryBytes{0};  ///< Approximate heap usage of the index.
+    };
+
+    /// @brief Inverted index from search text trigrams to objects.
+    ///
+    /// Like SecondaryIndexMap it does not own the objects. It is not synchronized:
+    /// modify it from one thread, and only while no other thread queries it.
+    class TrigramIndex final
+    {
+    public:
+        /// @brief Needles shorter than this cannot be answered by the index.
+        static constexpr size_t MIN_NEEDLE_LENGTH = 3;
+
+        /// @brief Index an object, or re-index it if its search text changed since the last call.
+        void Update(const DataObject *dataObject);
+
+        /// @brief Remove an object from the index (no-op if it is not indexed).
+        void Erase(const DataObject *dataObject);
+
+        /// @brief Remove all entries.
+        void Clear() noexcept;
+
+        /// @brief Find the objects that may contain all of the given needles.
+        /// @param needles Substrings every match must contain (case-insensitive). Needles
+        ///        the index cannot answer (shorter than MIN_NEEDLE_LENGTH, non-ASCII) are ignored.
+        /// @param objects The indexed objects in the order the result should have.
+        /// @param candidates Receives the candidates in the order of @p objects: a superset of
+        ///        the objects containing every needle, to be verified by the caller.
+        /// @return false if none of the needles can be answered, or if even the rarest trigram
+        ///         occurs in so many objects that a scan is faster; @p candidates is then unchanged.
+        bool FindCandidates(
+            std::span<const std::string_view> needles, std::span<DataObject *const> objects, std::vector<DataObject *> &candidates) const;
+
+        /// @brief Number of live indexed objects.
+        size_t GetObjectCount() const noexcept
+        {
+            return m_ids.size();
+        }
+
+        /// @brief Get the size of the index, see TrigramIndexStatistics.
+        /// Walks all posting lists; not meant to be called on every refresh.
+        TrigramIndexStatistics GetStatistics() const noexcept;
+
+        /// @brief Number of compactions so far; changes when the index was rebuilt from its live entries.
+        uint64_t GetCompactionCount() const noexcept
+        {
+            return m_compactionCount;
+        }
+
+    private:
+        /// An indexed object; dead entries (pObject == nullptr) wait for Compact().
+        struct Entry final
+        {
+            const DataObject *pObject{nullptr};
+            size_t TextHash{0};
+        };
+
+        void AddPostings(uint32_t id, std::string_view text);
+        bool NeedsCompaction() const noexcept;
+        void Compact();
+
+        std::unordered_map<const DataObject *, uint32_t> m_ids;       ///< Object -> id of its live entry.
+        std::vector<Entry> m_entries;                                 ///< Entries by id; ids only grow until Compact().
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings; ///< Trigram -> ascending ids.
+        size_t m_postingCount{0};                                     ///< Sum of all posting list sizes.
+        size_t m_deadCount{0};                                        ///< Dead entries in m_entries.
+        uint64_t m_compactionCount{0};                                ///< See GetCompactionCount().
+        std::vector<uint32_t> m_trigrams;                             ///< Scratch buffer of AddPostings().
+    };
+} // namespace pserv
@@ -15,6 +15,19 @@ namespace pserv
           m_dataObjects{dataObjects},
           m_hWnd{hWnd}
     {
+        // The caller's list is released once the action that opened us has been dispatched
+        for (auto *dataObject : m_dataObjects)
+        {
+            dataObject->Retain(REFCOUNT_DEBUG_ARGS);
+        }
+    }
+
+    DataPropertiesDialog::~DataPropertiesDialog()
+    {
+        for (auto *dataObject : m_dataObjects)
+        {
+            dataObject->Release(REFCOUNT_DEBUG_ARGS);
+        }
     }
 
     void DataPropertiesDialog::Open()
@@ -448,6 +461,8 @@ namespace pserv
                     // Build dispatch context for this action
                     DataActionDispatchContext ctx;
                     ctx.m_pController = m_controller;
+                    // The context releases its objects when it goes out of scope
+                    dataObject->Retain(REFCOUNT_DEBUG_ARGS);
                     ctx.m_selectedObjects = {const_cast<DataObject *>(dataObject)};
                     ctx.m_hWnd = m_hWnd;
                     ctx.m_pAsyncOp = nullptr;
@@ -29,7 +29,7 @@ namespace pserv
     class DataPropertiesDialog final
     {
     private:
-        const std::vector<DataObject *> &m_dataObjects;
+        std::vector<DataObject *> m_dataObjects; ///< Retained while the dialog exists.
         DataController *m_controller{nullptr};
         HWND m_hWnd{nullptr};
         int m_activeTabIndex{0};
@@ -40,7 +40,8 @@ namespace pserv
 
     public:
         DataPropertiesDialog(DataController *controller, const std::vector<DataObject *> &dataObjects, HWND hWnd);
-        ~DataPropertiesDialog() = default;
+        ~DataPropertiesDialog();
+        DECLARE_NON_COPYABLE(DataPropertiesDialog)
 
         /// @brief Open the dialog.
         void Open();
@@ -8,6 +8,7 @@
 #include <core/data_object.h>
 #include <core/data_controller_library.h>
 #include <main_window.h>
+#include <utils/format_utils.h>
 #include <utils/string_utils.h>
 #include <utils/win32_error.h>
 #include <core/data_controller.h>
@@ -43,6 +44,7 @@ namespace pserv
         {
             DestroyWindow(m_hWnd);
         }
+        m_views.clear(); // Stops their filter workers before the controllers go away
         m_Controllers.Clear();
     }
 
@@ -268,6 +270,7 @@ namespace pserv
                         // Refresh controller to show updated state
                         if (pWindow->m_dispatchContext.m_pController)
                         {
+                            pWindow->m_dispatchContext.m_pController->WaitForBackgroundRefresh();
                             pWindow->m_dispatchContext.m_pController->Refresh();
                         }
                     }
@@ -284,6 +287,7 @@ namespace pserv
                         // Refresh controller to show actual state
                         if (pWindow->m_dispatchContext.m_pController)
                         {
+                            pWindow->m_dispatchContext.m_pController->WaitForBackgroundRefresh();
                             pWindow->m_dispatchContext.m_pController->Refresh();
                         }
                     }
@@ -1363,6 +1367,7 @@ namespace pserv
             spdlog::debug("F5 pressed, refreshing current view");
             try
             {
+                m_pCurrentController->WaitForBackgroundRefresh();
                 m_pCurrentController->Refresh();
                 m_pCurrentController->ClearRefreshFlag();
             }
@@ -1373,7 +1378,7 @@ namespace pserv
         }
 
         // Delete key to execute delete action on selected items
-        if (ImGui::IsKeyPressed(ImGuiKey_Delete) && m_pCurrentController && !m_dispatchContext.m_selectedObjects.empty())
+        if (ImGui::IsKeyPressed(ImGuiKey_Delete) && m_pCurrentController && !m_selection.IsEmpty() && ResolveSelectedObjects())
         {
             // Find a "Delete" action for the first selected object
             const DataObject* firstSelected = m_dispatchContext.m_selectedObjects[0];
@@ -1389,6 +1394,7 @@ namespace pserv
                     break;
                 }
             }
+            ReleaseSelectedObjects();
         }
 
         // Create tab bar with placeholder tabs
@@ -1492,24 +1498,14 @@ namespace pserv
             {
                 if (m_pCurrentController)
                 {
-                    spdlog::debug("Auto-refreshing {}", m_pCurrentController->GetControllerName());
-                    m_pCurrentController->Refresh(true);
-
-                    // Clean up selection: remove objects no longer in container
-                    const auto& container = m_pCurrentController->GetDataObjects();
-                    auto it = m_dispatchContext.m_selectedObjects.begin();
-                    while (it != m_dispatchContext.m_selectedObjects.end())
+                    // Runs on a worker; RenderDataController() picks up the published snapshot
+                    if (m_pCurrentController->RefreshInBackground())
                     {
-                        auto* obj = *it;
-                        if (!container.GetByStableId<DataObject>(obj->GetStableID()))
-                        {
-                            obj->Release(REFCOUNT_DEBUG_ARGS);
-                            it = m_dispatchContext.m_selectedObjects.erase(it);
-                        }
-                        else
-                        {
-                            ++it;
-                        }
+                        spdlog::debug("Auto-refreshing {}", m_pCurrentController->GetControllerName());
+                    }
+                    else
+                    {
+                        spdlog::debug("Auto-refresh of {} skipped: previous refresh still running", m_pCurrentController->GetControllerName());
                     }
                 }
                 m_lastAutoRefreshTime = now;
@@ -1583,6 +1579,7 @@ namespace pserv
             {
                 try
                 {
+                    controller->WaitForBackgroundRefresh();
                     controller->Refresh();
                     controller->ClearRefreshFlag();
                 }
@@ -1599,6 +1596,7 @@ namespace pserv
         }
 
         // Filter input box
+        auto &view = GetView(controller);
         ImGui::SameLine();
         ImGui::SetNextItemWidth(300.0f);
 
@@ -1606,6 +1604,26 @@ namespace pserv
             const auto label{std::format("##filter_{}", controllerName)};
             const auto hint{std::format("Filter {}...", controllerName)};
             ImGui::InputTextWithHint(label.c_str(), hint.c_str(), m_filterText, IM_ARRAYSIZE(m_filterText));
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Text, or a query such as: User:SYSTEM WorkingSetSize>500MB Name~^svc\n"
+                                  "Operators : = != < <= > >= ~ (regex), combined with AND, OR, NOT and ( )");
+            }
+
+            // The query belongs to the displayed rows; while it is invalid, the text is matched as typed
+            const auto &queryError = view.GetQuery().GetError();
+            if (m_filterText[0] != '\0' && !queryError.empty())
+            {
+                ImGui::SameLine();
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
+                ImGui::TextUnformatted(queryError.c_str());
+                ImGui::PopStyleColor();
+            }
+            if (view.IsFiltering())
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("filtering...");
+            }
         }
 
         ImGui::Separator();
@@ -1618,9 +1636,10 @@ namespace pserv
         const auto &columns = controller->GetColumns();
 
         // Declare these here so they're available for status bar later
-        std::vector<DataObject *> filteredDataObjects;
+        std::span<DataObject *const> filteredDataObjects;
         const DataObjectContainer *pAllDataObjects = nullptr;
-        ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable |
+        std::shared_ptr<const DataObjectContainer> snapshot; // Keeps the displayed objects alive for this frame
+        ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable |
                                 ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY |
                                 ImGuiTableFlags_SizingFixedFit;
 
@@ -1725,6 +1744,23 @@ namespace pserv
                     }
                 }
 
+                // Restore the saved (possibly multi-column) sort order; this marks the sort specs dirty
+                auto savedSortSpecs = SortSpec::ParseList(configSection->sortSpecs.get(), columns);
+                if (savedSortSpecs.empty() && configSection->sortColumn.get() >= 0)
+                {
+                    savedSortSpecs = SortSpec::ParseList(std::to_string(configSection->sortColumn.get()), columns);
+                    if (!savedSortSpecs.empty())
+                    {
+                        savedSortSpecs[0].Ascending = configSection->sortAscending.get();
+                    }
+                }
+                for (size_t i = 0; i < savedSortSpecs.size(); ++i)
+                {
+                    ImGui::TableSetColumnSortDirection(savedSortSpecs[i].ColumnIndex,
+                        savedSortSpecs[i].Ascending ? ImGuiSortDirection_Ascending : ImGuiSortDirection_Descending,
+                        i > 0);
+                }
+
                 lastOrderAppliedController = controllerName;
             }
 
@@ -1736,61 +1772,47 @@ namespace pserv
             {
                 if (sortSpecs->SpecsDirty)
                 {
-                    // Sort is requested
+                    // Sort is requested (shift-click adds secondary sort columns)
                     if (sortSpecs->SpecsCount > 0)
                     {
-                        const ImGuiTableColumnSortSpecs &spec = sortSpecs->Specs[0];
-                        int columnIndex = spec.ColumnIndex;
-                        bool ascending = (spec.SortDirection == ImGuiSortDirection_Ascending);
+                        std::vector<SortSpec> specs;
+                        for (int i = 0; i < sortSpecs->SpecsCount; ++i)
+                        {
+                            const ImGuiTableColumnSortSpecs &spec = sortSpecs->Specs[i];
+                            specs.push_back(SortSpec{spec.ColumnIndex, spec.SortDirection == ImGuiSortDirection_Ascending});
+                        }
 
-                        spdlog::info("[SORT] Controller '{}': Sorting by column {} ({})", controllerName, columnIndex, ascending ? "ascending" : "descending");
-                        controller->Sort(columnIndex, ascending);
+                        spdlog::info("[SORT] Controller '{}': Sorting by columns {}", controllerName, SortSpec::FormatList(specs));
+                        controller->Sort(specs);
                         spdlog::info("[SORT] Controller '{}': Sort() completed", controllerName);
                     }
                     sortSpecs->SpecsDirty = false;
                 }
             }
 
-            // Get data objects AFTER sorting
-            pAllDataObjects = &controller->GetDataObjects();
-
-            // Filter data objects based on search text
-            if (m_filterText[0] != '\0')
+            // Rows of the snapshot published AFTER sorting. The view only filters again when the snapshot
+            // or the filter text changed, large views in the background: until that result is ready,
+            // the previous rows stay on screen with the snapshot they belong to.
+            const bool bRowsChanged = view.Update(m_filterText);
+            const bool bHasRows = view.HasRows();
+            snapshot = bHasRows ? view.GetSnapshot() : controller->GetSnapshot();
+            const bool bSnapshotChanged = snapshot != m_pDisplayedSnapshot;
+            if (bSnapshotChanged)
             {
-                std::string lowerFilter = utils::ToLower(m_filterText);
-                for (auto *dataObject : *pAllDataObjects)
-                {
-                    if (dataObject->MatchesFilter(lowerFilter))
-                    {
-                        filteredDataObjects.push_back(dataObject);
-                    }
-                }
+                // The selection is keyed by stable key and carries over as is
+                m_pDisplayedSnapshot = snapshot;
             }
-            else
-            {
-                // No filter - show all data Objects
-                filteredDataObjects.assign(pAllDataObjects->begin(), pAllDataObjects->end());
-            }
-
-            auto &selectedObjects = m_dispatchContext.m_selectedObjects;
-            auto selectedIt = selectedObjects.begin();
-            while (selectedIt != selectedObjects.end())
+            pAllDataObjects = snapshot.get();
+            if (bHasRows)
             {
-                if (std::find(filteredDataObjects.begin(), filteredDataObjects.end(), *selectedIt) == filteredDataObjects.end())
-                {
-                    (*selectedIt)->Release(REFCOUNT_DEBUG_ARGS);
-                    selectedIt = selectedObjects.erase(selectedIt);
-                }
-                else
-                {
-                    ++selectedIt;
-                }
+                filteredDataObjects = view.GetRows();
             }
 
-            if (m_lastClickedObject &&
-                std::find(filteredDataObjects.begin(), filteredDataObjects.end(), m_lastClickedObject) == filteredDataObjects.end())
+            // Drop selected objects that were filtered out or no longer exist. Clicks only ever select
+            // visible rows, so this is needed only when the rows changed.
+            if (bHasRows && snapshot && (bRowsChanged || bSnapshotChanged))
             {
-                m_lastClickedObject = nullptr;
+                m_selection.RetainVisible(*snapshot, filteredDataObjects);
             }
 
             // Lambda to render a single row (shared between clipper and non-clipper paths)
@@ -1824,31 +1846,31 @@ namespace pserv
                 for (size_t i = 0; i < columns.size(); ++i)
                 {
                     ImGui::TableSetColumnIndex(static_cast<int>(i));
-                    std::string value = dataObject->GetProperty(static_cast<int>(i));
+                    const std::string &value = view.GetCellText(dataObject, static_cast<int>(i));
 
                     // First column: use selectable to make row clickable
                     if (i == 0)
                     {
                         // Check if this object is selected
-                        bool isSelected = std::find(m_dispatchContext.m_selectedObjects.begin(), m_dispatchContext.m_selectedObjects.end(), dataObject) !=
-                                          m_dispatchContext.m_selectedObjects.end();
+                        bool isSelected = m_selection.Contains(dataObject);
 
-                        if (ImGui::Selectable(value.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick))
+                        const bool bClicked = ImGui::Selectable(value.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick);
+                        if (ImGui::IsItemVisible())
+                        {
+                            m_rowsOnScreen.push_back(dataObject);
+                        }
+                        if (bClicked)
                         {
                             // Handle double-click: open properties dialog
                             if (ImGui::IsMouseDoubleClicked(0))
                             {
                                 // Select only this item for properties dialog
-                                for (auto *obj : m_dispatchContext.m_selectedObjects)
+                                m_selection.SelectOnly(dataObject);
+                                if (ResolveSelectedObjects())
                                 {
-                                    obj->Release(REFCOUNT_DEBUG_ARGS);
+                                    theDataPropertiesAction.Execute(m_dispatchContext);
+                                    ReleaseSelectedObjects();
                                 }
-                                m_dispatchContext.m_selectedObjects.clear();
-                                dataObject->Retain(REFCOUNT_DEBUG_ARGS);
-                                m_dispatchContext.m_selectedObjects.push_back(dataObject);
-                                m_lastClickedObject = dataObject;
-
-                                theDataPropertiesAction.Execute(m_dispatchContext);
                             }
                             else
                             {
@@ -1858,58 +1880,21 @@ namespace pserv
                             if (io.KeyCtrl)
                             {
                                 // Ctrl+Click: toggle selection
-                                if (isSelected)
-                                {
-                                    m_dispatchContext.m_selectedObjects.erase(
-                                        std::remove(m_dispatchContext.m_selectedObjects.begin(), m_dispatchContext.m_selectedObjects.end(), dataObject),
-                                        m_dispatchContext.m_selectedObjects.end());
-                                    dataObject->Release(REFCOUNT_DEBUG_ARGS);
-                                }
-                                else
-                                {
-                                    dataObject->Retain(REFCOUNT_DEBUG_ARGS);
-                                    m_dispatchContext.m_selectedObjects.push_back(dataObject);
-                                }
-                                m_lastClickedObject = dataObject;
+                                m_selection.Toggle(dataObject);
                             }
-                            else if (io.KeyShift && m_lastClickedObject != nullptr)
+                            else if (io.KeyShift)
                             {
-                                // Shift+Click: range selection
-                                // Find the range between last clicked and current
-                                auto lastIt = std::find(filteredDataObjects.begin(), filteredDataObjects.end(), m_lastClickedObject);
-                                auto currentIt = std::find(filteredDataObjects.begin(), filteredDataObjects.end(), dataObject);
-
-                                if (lastIt != filteredDataObjects.end() && currentIt != filteredDataObjects.end())
+                                // Shift+Click: range selection between the last clicked row and this one,
+                                // or a plain click if that row is gone
+                                if (!m_selection.SelectRange(*snapshot, filteredDataObjects, dataObject))
                                 {
-                                    // Clear selection first
-                                    for (auto *obj : m_dispatchContext.m_selectedObjects)
-                                    {
-                                        obj->Release(REFCOUNT_DEBUG_ARGS);
-                                    }
-                                    m_dispatchContext.m_selectedObjects.clear();
-
-                                    // Select range
-                                    auto start = (lastIt < currentIt) ? lastIt : currentIt;
-                                    auto end = (lastIt < currentIt) ? currentIt : lastIt;
-
-                                    for (auto it = start; it <= end; ++it)
-                                    {
-                                        (*it)->Retain(REFCOUNT_DEBUG_ARGS);
-                                        m_dispatchContext.m_selectedObjects.push_back(*it);
-                                    }
+                                    m_selection.SelectOnly(dataObject);
                                 }
                             }
                             else
                             {
                                 // Normal click: clear selection and select only this one
-                                for (auto *obj : m_dispatchContext.m_selectedObjects)
-                                {
-                                    obj->Release(REFCOUNT_DEBUG_ARGS);
-                                }
-                                m_dispatchContext.m_selectedObjects.clear();
-                                dataObject->Retain(REFCOUNT_DEBUG_ARGS);
-                                m_dispatchContext.m_selectedObjects.push_back(dataObject);
-                                m_lastClickedObject = dataObject;
+                                m_selection.SelectOnly(dataObject);
                             }
                             }
                         }
@@ -1926,15 +1911,9 @@ namespace pserv
                         if (ImGui::BeginPopupContextItem())
                         {
                             // If right-clicked on non-selected item, select only that one
-                            if (!isSelected)
+                            if (!m_selection.Contains(dataObject))
                             {
-                                for (auto *obj : m_dispatchContext.m_selectedObjects)
-                                {
-                                    obj->Release(REFCOUNT_DEBUG_ARGS);
-                                }
-                                m_dispatchContext.m_selectedObjects.clear();
-                                dataObject->Retain(REFCOUNT_DEBUG_ARGS);
-                                m_dispatchContext.m_selectedObjects.push_back(dataObject);
+                                m_selection.SelectOnly(dataObject);
                             }
 
                             // Get all actions and filter to those available for this object
@@ -1964,9 +1943,9 @@ namespace pserv
 
                                 // Show count if multiple objects selected
                                 std::string menuLabel = action->GetName();
-                                if (m_dispatchContext.m_selectedObjects.size() > 1)
+                                if (m_selection.GetSize() > 1)
                                 {
-                                    menuLabel += std::format(" ({} selected)", m_dispatchContext.m_selectedObjects.size());
+                                    menuLabel += std::format(" ({} selected)", m_selection.GetSize());
                                 }
 
                                 // Color destructive actions red
@@ -1975,9 +1954,10 @@ namespace pserv
                                     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
                                 }
 
-                                if (ImGui::MenuItem(menuLabel.c_str()))
+                                if (ImGui::MenuItem(menuLabel.c_str()) && ResolveSelectedObjects())
                                 {
                                     action->Execute(m_dispatchContext);
+                                    ReleaseSelectedObjects();
                                 }
 
                                 if (action->IsDestructive())
@@ -2056,6 +2036,8 @@ namespace pserv
 
             ImGui::EndTable();
 
+            ReportObjectsOfInterest(controller);
+
             // Save table state periodically (throttled inside the method)
             SaveCurrentTableState();
         }
@@ -2066,26 +2048,14 @@ namespace pserv
         // Calculate statistics
         size_t visibleCount = filteredDataObjects.size();
         size_t totalCount = pAllDataObjects ? pAllDataObjects->GetSize() : 0;
-        size_t selectedCount = m_dispatchContext.m_selectedObjects.size();
-        size_t highlightedCount = 0;
-        size_t disabledCount = 0;
+        size_t selectedCount = m_selection.GetSize();
         size_t filteredCount = totalCount - visibleCount;
 
-        if (pAllDataObjects)
-        {
-            for (const auto *dataObject : *pAllDataObjects)
-            {
-                VisualState state = controller->GetVisualState(dataObject);
-                if (state == VisualState::Highlighted)
-                {
-                    highlightedCount++;
-                }
-                else if (state == VisualState::Disabled)
-                {
-                    disabledCount++;
-                }
-            }
-        }
+        // Maintained per refresh by the controller, so this is O(1) per frame
+        const DataObjectStatistics::Values statistics = pAllDataObjects ? pAllDataObjects->GetStatistics().GetTotals() : DataObjectStatistics::Values{};
+        const bool bHasVisualStateCounts = !pAllDataObjects || pAllDataObjects->GetStatistics().HasVisualStateCounts();
+        size_t highlightedCount = statistics.HighlightedCount;
+        size_t disabledCount = statistics.DisabledCount;
 
         // Display status bar with statistics in compartment style
         ImGui::BeginGroup();
@@ -2093,11 +2063,27 @@ namespace pserv
         ImGui::SameLine();
         ImGui::TextDisabled("|");
         ImGui::SameLine();
-        ImGui::Text("%zu highlighted", highlightedCount);
-        ImGui::SameLine();
-        ImGui::TextDisabled("|");
-        ImGui::SameLine();
-        ImGui::Text("%zu disabled", disabledCount);
+        if (bHasVisualStateCounts)
+        {
+            ImGui::Text("%zu highlighted", highlightedCount);
+            ImGui::SameLine();
+            ImGui::TextDisabled("|");
+            ImGui::SameLine();
+            ImGui::Text("%zu disabled", disabledCount);
+        }
+        else
+        {
+            // Counting only the objects loaded so far would change with scrolling
+            ImGui::TextDisabled("? highlighted");
+            ImGui::SameLine();
+            ImGui::TextDisabled("|");
+            ImGui::SameLine();
+            ImGui::TextDisabled("? disabled");
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Shown once the fields they depend on are loaded for all objects");
+            }
+        }
         ImGui::SameLine();
         ImGui::TextDisabled("|");
         ImGui::SameLine();
@@ -2111,6 +2097,18 @@ namespace pserv
         ImGui::SameLine();
         ImGui::Text("%zu selected", selectedCount);
 
+        // Controller-specific sums, e.g. running services or total working set
+        const auto &aggregates = controller->GetAggregates();
+        for (size_t i = 0; i < aggregates.size(); ++i)
+        {
+            const uint64_t value = statistics.Aggregates[i];
+            const std::string text = aggregates[i].DataType == ColumnDataType::Size ? utils::FormatSize(value) : std::to_string(value);
+            ImGui::SameLine();
+            ImGui::TextDisabled("|");
+            ImGui::SameLine();
+            ImGui::Text("%s %s", text.empty() ? "0" : text.c_str(), aggregates[i].Label.c_str());
+        }
+
         // Auto-refresh indicator
         if (config::theSettings.autoRefresh.enabled.get())
         {
@@ -2246,13 +2244,17 @@ namespace pserv
         }
         std::string currentOrder = orderStream.str();
 
+        const auto &currentSortSpecs = m_pCurrentController->GetSortSpecs();
+        std::string currentSort = SortSpec::FormatList(currentSortSpecs);
+
         // Check if state actually changed
         static std::string lastWidths;
         static std::string lastOrder;
+        static std::string lastSort;
         static std::string lastController;
         std::string currentController = m_pCurrentController->GetControllerName();
 
-        if (!force && currentController == lastController && currentWidths == lastWidths && currentOrder == lastOrder)
+        if (!force && currentController == lastController && currentWidths == lastWidths && currentOrder == lastOrder && currentSort == lastSort)
         {
             spdlog::trace("Skipping save: table state unchanged");
             return;
@@ -2262,17 +2264,25 @@ namespace pserv
         lastController = currentController;
         lastWidths = currentWidths;
         lastOrder = currentOrder;
+        lastSort = currentSort;
 
         spdlog::debug("Proceeding with save");
         spdlog::debug("Column widths: {}", currentWidths);
         spdlog::debug("Column order: {}", currentOrder);
+        spdlog::debug("Sort order: {}", currentSort);
 
         // Save to config
         configSection->columnWidths.set(currentWidths);
         configSection->columnOrder.set(currentOrder);
+        if (!currentSortSpecs.empty())
+        {
+            configSection->sortSpecs.set(currentSort);
+            configSection->sortColumn.set(currentSortSpecs[0].ColumnIndex);
+            configSection->sortAscending.set(currentSortSpecs[0].Ascending);
+        }
         configSection->save(*m_pConfigBackend);
 
-        spdlog::info("Current table state saved: widths={}, order={}", currentWidths, currentOrder);
+        spdlog::info("Current table state saved: widths={}, order={}, sort={}", currentWidths, currentOrder, currentSort);
     }
 
     bool MainWindow::IsWindowMaximized() const
@@ -2468,6 +2478,7 @@ namespace pserv
                     {
                         try
                         {
+                            m_pCurrentController->WaitForBackgroundRefresh();
                             m_pCurrentController->Refresh();
                         }
                         catch (const std::exception &e)
@@ -2669,6 +2680,76 @@ namespace pserv
         }
     }
 
+    DataView &MainWindow::GetView(const DataController *controller)
+    {
+        auto &view = m_views[controller];
+        if (!view)
+        {
+            view = std::make_unique<DataView>(*controller);
+        }
+        return *view;
+    }
+
+    bool MainWindow::ResolveSelectedObjects()
+    {
+        // The objects for actions are looked up only when an action runs, not on every refresh
+        ReleaseSelectedObjects();
+        if (m_pDisplayedSnapshot)
+        {
+            m_selection.Resolve(*m_pDisplayedSnapshot, m_dispatchContext.m_selectedObjects);
+        }
+        return !m_dispatchContext.m_selectedObjects.empty();
+    }
+
+    void MainWindow::ReleaseSelectedObjects()
+    {
+        // Called once an action is dispatched: async operations copy what they need and the
+        // properties dialog retains its own objects. Holding on to them would keep their
+        // snapshot from being recycled by the next refresh (see DataController::StartRefresh()).
+        for (auto *dataObject : m_dispatchContext.m_selectedObjects)
+        {
+            dataObject->Release(REFCOUNT_DEBUG_ARGS);
+        }
+        m_dispatchContext.m_selectedObjects.clear();
+    }
+
+    void MainWindow::ReportObjectsOfInterest(DataController *controller)
+    {
+        // Controllers with lazily loaded fields load them for the rows on screen and the selection.
+        // Report those only when they changed, not on every frame.
+        const bool bFiltered = m_filterText[0] != '\0';
+        if (controller != m_pReportedController || bFiltered != m_bReportedFiltered ||
+            m_selection.GetRevision() != m_reportedSelectionRevision || m_rowsOnScreen != m_reportedRowsOnScreen)
+        {
+            const auto selectedKeys = m_selection.GetKeys();
+            std::vector<StableKey> stableKeys(selectedKeys.begin(), selectedKeys.end());
+            for (const auto *dataObject : m_rowsOnScreen)
+            {
+                stableKeys.push_back(dataObject->GetStableKey());
+            }
+            m_bObjectsOfInterestRefreshPending = controller->SetObjectsOfInterest(std::move(stableKeys), bFiltered);
+
+            m_pReportedController = controller;
+            m_bReportedFiltered = bFiltered;
+            m_reportedSelectionRevision = m_selection.GetRevision();
+            m_reportedRowsOnScreen.swap(m_rowsOnScreen);
+        }
+        m_rowsOnScreen.clear();
+
+        // Fields that arrived in the background show up with the next refresh. While one is running it
+        // may already include them, so ask again when it has finished.
+        if (!m_bObjectsOfInterestRefreshPending && !controller->IsRefreshingInBackground() && controller->HasPendingLazyFields())
+        {
+            m_bObjectsOfInterestRefreshPending = true;
+        }
+
+        // Load the missing fields now instead of waiting for the next auto-refresh (if any)
+        if (m_bObjectsOfInterestRefreshPending && controller->RefreshInBackground())
+        {
+            m_bObjectsOfInterestRefreshPending = false;
+        }
+    }
+
     bool MainWindow::ShouldAutoRefresh() const
     {
         auto &settings = config::theSettings.autoRefresh;
@@ -3,6 +3,8 @@
 #ifndef PSERV_CONSOLE_BUILD
 #include <core/data_controller_library.h>
 #include <core/data_action_dispatch_context.h>
+#include <core/data_object_selection.h>
+#include <core/data_view.h>
 
 struct ImGuiTable; // Forward declaration
 
@@ -100,7 +102,16 @@ namespace pserv
         ImGuiTable *m_pCurrentTable{nullptr}; // Cached pointer to services table
         char m_filterText[256]{};             // Filter text for services view
 
-        const DataObject *m_lastClickedObject{nullptr}; // For shift-click range selection
+        std::unordered_map<const DataController *, std::unique_ptr<DataView>> m_views; // Cached rows per controller, see GetView()
+
+        DataObjectSelection m_selection;                                  // Selected rows, by stable key
+        std::shared_ptr<const DataObjectContainer> m_pDisplayedSnapshot; // Snapshot the selection is resolved in
+        std::vector<const DataObject *> m_rowsOnScreen;                   // Rows drawn this frame, see ReportObjectsOfInterest()
+        std::vector<const DataObject *> m_reportedRowsOnScreen;           // Rows last reported to the controller
+        const DataController *m_pReportedController{nullptr};            // Controller they were reported to
+        uint64_t m_reportedSelectionRevision{0};                          // Selection revision last reported
+        bool m_bReportedFiltered{false};                                  // Filter state last reported
+        bool m_bObjectsOfInterestRefreshPending{false};                   // Reported objects lack fields, refresh when possible
         float m_pendingFontSize{0.0f};                  // Pending font size change (0 = no change pending)
         bool m_bWindowFocused{true};                    // Track window focus state for title bar styling
         COLORREF m_accentColor{0};                      // Windows accent color
@@ -117,6 +128,10 @@ namespace pserv
 
         // Helper methods
         bool ShouldAutoRefresh() const;
+        DataView &GetView(const DataController *controller);
+        bool ResolveSelectedObjects();
+        void ReleaseSelectedObjects();
+        void ReportObjectsOfInterest(DataController *controller);
         void SaveWindowState();
         void SaveCurrentTableState(bool force = false);
         void RenderProgressDialog();
@@ -31,15 +31,11 @@ namespace pserv
         return PropertyValue{GetProperty(propertyId)};
     }
 
-    bool EnvironmentVariableInfo::MatchesFilter(const std::string &filter) const
+    void EnvironmentVariableInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        std::string lowerFilter = utils::ToLower(filter);
-        return utils::ToLower(m_name).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(m_value).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(GetScopeString()).find(lowerFilter) != std::string::npos;
+        AppendSearchField(text, m_name);
+        AppendSearchField(text, m_value);
+        AppendSearchField(text, GetScopeString());
     }
 
     std::string EnvironmentVariableInfo::GetScopeString() const
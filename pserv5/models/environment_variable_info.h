@@ -5,6 +5,7 @@
 /// user environment variable from the Windows registry.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -28,7 +29,7 @@ namespace pserv
     /// Stores environment variable information from registry:
     /// - HKCU\\Environment for user variables
     /// - HKLM\\SYSTEM\\CurrentControlSet\\Control\\Session Manager\\Environment for system variables
-    class EnvironmentVariableInfo : public DataObject
+    class EnvironmentVariableInfo : public DataObject, public PooledObject<EnvironmentVariableInfo>
     {
     private:
         std::string m_name;
@@ -42,7 +43,6 @@ namespace pserv
         // DataObject interface
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(EnvironmentVariableProperty::Name));
@@ -56,6 +56,16 @@ namespace pserv
         {
             return GetStableID(m_scope, m_name);
         }
+
+        static StableKey GetStableKey(EnvironmentVariableScope scope, std::string_view name)
+        {
+            return StableKey::FromPair(static_cast<uint64_t>(scope), StableKey::HashString(name));
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_scope, m_name);
+        }
         // Getters
         const std::string &GetName() const
         {
@@ -74,12 +84,15 @@ namespace pserv
         // Setters (for editing)
         void SetName(std::string name)
         {
-            m_name = std::move(name);
+            UpdateSearchableValue(m_name, std::move(name));
         }
         void SetValue(std::string value)
         {
-            m_value = std::move(value);
+            UpdateSearchableValue(m_value, std::move(value));
         }
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
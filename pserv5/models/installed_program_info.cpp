@@ -29,14 +29,14 @@ namespace pserv
         uint64_t estimatedSizeBytes)
     {
         // Set flags for DataObject base class
-        m_publisher = publisher;
-        m_installLocation = installLocation;        
-        m_installDate = installDate;
-        m_estimatedSize = estimatedSize;        
-        m_estimatedSizeBytes = estimatedSizeBytes;        
-        m_comments = comments;
-        m_helpLink = helpLink;
-        m_urlInfoAbout = urlInfoAbout;
+        UpdateSearchableValue(m_publisher, std::move(publisher));
+        UpdateValue(m_installLocation, std::move(installLocation));        
+        UpdateValue(m_installDate, std::move(installDate));
+        UpdateValue(m_estimatedSize, std::move(estimatedSize));        
+        UpdateValue(m_estimatedSizeBytes, estimatedSizeBytes);        
+        UpdateValue(m_comments, std::move(comments));
+        UpdateValue(m_helpLink, std::move(helpLink));
+        UpdateValue(m_urlInfoAbout, std::move(urlInfoAbout));
     }
     
     
@@ -90,18 +90,10 @@ namespace pserv
         }
     }
 
-    bool InstalledProgramInfo::MatchesFilter(const std::string &filter) const
+    void InstalledProgramInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        // filter is pre-lowercased by caller
-        if (pserv::utils::ToLower(m_displayName).find(filter) != std::string::npos)
-            return true;
-        if (pserv::utils::ToLower(m_publisher).find(filter) != std::string::npos)
-            return true;
-
-        return false;
+        AppendSearchField(text, m_displayName);
+        AppendSearchField(text, m_publisher);
     }
 
 } // namespace pserv
\ No newline at end of file
@@ -5,6 +5,7 @@
 /// application from the Windows registry uninstall keys.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -30,7 +31,7 @@ namespace pserv
     /// - Installation: location, date, size
     /// - Uninstall: uninstall command string
     /// - Links: help URL, about URL
-    class InstalledProgramInfo : public DataObject
+    class InstalledProgramInfo : public DataObject, public PooledObject<InstalledProgramInfo>
     {
     public:
         InstalledProgramInfo(std::string displayName, std::string displayVersion, std::string uninstallString);
@@ -48,7 +49,6 @@ namespace pserv
         // DataObject overrides
         std::string GetProperty(int columnIndex) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
         
         static std::string GetStableID(const std::string &displayName, const std::string &displayVersion, const std::string& uninstallString)
         {
@@ -60,6 +60,17 @@ namespace pserv
             return GetStableID(m_displayName, m_displayVersion, m_uninstallString);
         }
 
+        static StableKey GetStableKey(std::string_view displayName, std::string_view displayVersion, std::string_view uninstallString)
+        {
+            return StableKey::FromPair(
+                StableKey::HashString(displayName), StableKey::HashString(uninstallString, StableKey::HashString(displayVersion)));
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_displayName, m_displayVersion, m_uninstallString);
+        }
+
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(ProgramProperty::DisplayName));
@@ -123,6 +134,9 @@ namespace pserv
         std::string m_comments;
         std::string m_helpLink;
         std::string m_urlInfoAbout;
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
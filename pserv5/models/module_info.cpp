@@ -17,9 +17,9 @@ namespace pserv
 
     void ModuleInfo::SetValues(void *baseAddress, uint32_t size, const std::string &path)
     {
-        m_baseAddress = baseAddress;
-        m_size = size;
-        m_path = path;
+        UpdateValue(m_baseAddress, baseAddress);
+        UpdateValue(m_size, size);
+        UpdateSearchableValue(m_path, path);
     }
     
     PropertyValue ModuleInfo::GetTypedProperty(int propertyId) const
@@ -59,11 +59,18 @@ namespace pserv
         }
     }
 
-    bool ModuleInfo::MatchesFilter(const std::string &filter) const
+    void ModuleInfo::BuildSearchText(std::string &text) const
     {
-        // filter is pre-lowercased by caller
-        return pserv::utils::ToLower(m_name).find(filter) != std::string::npos || pserv::utils::ToLower(m_path).find(filter) != std::string::npos ||
-               std::to_string(m_processId).find(filter) != std::string::npos;
+        AppendSearchField(text, m_name);
+        AppendSearchField(text, m_path);
+        AppendSearchField(text, std::to_string(m_processId));
+    }
+
+    std::optional<StableKey> ModuleInfo::GetSecondaryKey(SecondaryIndex index) const
+    {
+        if (index == SecondaryIndex::ProcessId)
+            return SecondaryKey::ForProcessId(m_processId);
+        return std::nullopt;
     }
 
 } // namespace pserv
@@ -5,6 +5,7 @@
 /// loaded in a process's address space.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -24,7 +25,7 @@ namespace pserv
     /// - Identity: module name and full path
     /// - Memory: base address and size in memory
     /// - Context: owning process ID
-    class ModuleInfo : public DataObject
+    class ModuleInfo : public DataObject, public PooledObject<ModuleInfo>
     {
     public:
         ModuleInfo(uint32_t processId, const std::string &name);
@@ -34,7 +35,7 @@ namespace pserv
         // DataObject interface
         std::string GetProperty(int column) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
+        std::optional<StableKey> GetSecondaryKey(SecondaryIndex index) const override;
         std::string GetItemName() const
         {
             return std::format("{} ({})", GetProperty(static_cast<int>(ModuleProperty::Name)), GetProperty(static_cast<int>(ModuleProperty::ProcessId)));
@@ -49,6 +50,16 @@ namespace pserv
         {
             return GetStableID(m_processId, m_name);
         }
+
+        static StableKey GetStableKey(uint32_t processId, std::string_view name)
+        {
+            return StableKey::FromPair(processId, StableKey::HashString(name));
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_processId, m_name);
+        }
         // Module-specific getters
         uint32_t GetProcessId() const
         {
@@ -77,6 +88,9 @@ namespace pserv
         uint32_t m_size;
         std::string m_name;
         std::string m_path;
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
@@ -23,11 +23,11 @@ namespace pserv
         DWORD processId,
         std::string processName)
     {
-        m_remoteAddress = remoteAddress;
-        m_remotePort = remotePort;
-        m_state = state;
-        m_processId = processId;
-        m_processName = processName;
+        UpdateSearchableValue(m_remoteAddress, std::move(remoteAddress));
+        UpdateSearchableValue(m_remotePort, remotePort);
+        UpdateSearchableValue(m_state, state);
+        UpdateSearchableValue(m_processId, processId);
+        UpdateSearchableValue(m_processName, std::move(processName));
     }
 
     std::string NetworkConnectionInfo::GetProperty(int propertyId) const
@@ -68,18 +68,23 @@ namespace pserv
         }
     }
 
-    bool NetworkConnectionInfo::MatchesFilter(const std::string &filter) const
+    void NetworkConnectionInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
+        AppendSearchField(text, GetProtocolString());
+        AppendSearchField(text, m_localAddress);
+        AppendSearchField(text, m_remoteAddress);
+        AppendSearchField(text, GetStateString());
+        AppendSearchField(text, m_processName);
+        AppendSearchField(text, std::to_string(m_localPort));
+        AppendSearchField(text, std::to_string(m_remotePort));
+        AppendSearchField(text, std::to_string(m_processId));
+    }
 
-        std::string lowerFilter = utils::ToLower(filter);
-        return utils::ToLower(GetProtocolString()).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(m_localAddress).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(m_remoteAddress).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(GetStateString()).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(m_processName).find(lowerFilter) != std::string::npos || std::to_string(m_localPort).find(filter) != std::string::npos ||
-               std::to_string(m_remotePort).find(filter) != std::string::npos || std::to_string(m_processId).find(filter) != std::string::npos;
+    std::optional<StableKey> NetworkConnectionInfo::GetSecondaryKey(SecondaryIndex index) const
+    {
+        if (index == SecondaryIndex::ProcessId)
+            return SecondaryKey::ForProcessId(m_processId);
+        return std::nullopt;
     }
 
     std::string NetworkConnectionInfo::GetProtocolString() const
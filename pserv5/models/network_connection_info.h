@@ -5,6 +5,7 @@
 /// connection/socket from the IP Helper API.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -54,7 +55,7 @@ namespace pserv
     /// - Protocol: TCP, UDP, IPv4, IPv6
     /// - State: TCP connection state
     /// - Owner: process ID and name
-    class NetworkConnectionInfo : public DataObject
+    class NetworkConnectionInfo : public DataObject, public PooledObject<NetworkConnectionInfo>
     {
     private:
         NetworkProtocol m_protocol;
@@ -89,9 +90,19 @@ namespace pserv
             return GetStableID(m_protocol, m_localAddress, m_localPort);
         }
 
+        static StableKey GetStableKey(NetworkProtocol protocol, std::string_view localAddress, DWORD localPort)
+        {
+            return StableKey::FromPair((static_cast<uint64_t>(protocol) << 32) | localPort, StableKey::HashString(localAddress));
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_protocol, m_localAddress, m_localPort);
+        }
+
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
+        std::optional<StableKey> GetSecondaryKey(SecondaryIndex index) const override;
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(NetworkConnectionProperty::Protocol));
@@ -111,6 +122,9 @@ namespace pserv
         std::string GetStateString() const;
         std::string GetLocalEndpoint() const;
         std::string GetRemoteEndpoint() const;
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
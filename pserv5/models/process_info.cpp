@@ -13,6 +13,20 @@ namespace pserv
         SetRunning(true);
     }
 
+    void ProcessInfo::SetDetails(const std::string &user, const std::string &path, const std::string &cmdLine)
+    {
+        SetUser(user);
+        SetPath(path);
+        SetCommandLine(cmdLine);
+        UpdateValue(m_bDetailsLoaded, true);
+    }
+
+    void ProcessInfo::ClearDetails()
+    {
+        SetDetails({}, {}, {});
+        UpdateValue(m_bDetailsLoaded, false);
+    }
+
     PropertyValue ProcessInfo::GetTypedProperty(int propertyId) const
     {
         switch (static_cast<ProcessProperty>(propertyId))
@@ -125,22 +139,28 @@ namespace pserv
         }
     }
 
-    bool ProcessInfo::MatchesFilter(const std::string &filter) const
+    void ProcessInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        // filter is pre-lowercased by caller
-        if (utils::ToLower(m_name).find(filter) != std::string::npos)
-            return true;
-        if (std::to_string(m_pid).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_user).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_path).find(filter) != std::string::npos)
-            return true;
-
-        return false;
+        AppendSearchField(text, m_name);
+        AppendSearchField(text, std::to_string(m_pid));
+        AppendSearchField(text, m_user);
+        AppendSearchField(text, m_path);
+    }
+
+    std::optional<StableKey> ProcessInfo::GetSecondaryKey(SecondaryIndex index) const
+    {
+        switch (index)
+        {
+        case SecondaryIndex::ProcessId:
+            return SecondaryKey::ForProcessId(m_pid);
+        case SecondaryIndex::User:
+            if (!m_user.empty())
+                return SecondaryKey::ForUser(m_user);
+            break;
+        default:
+            break;
+        }
+        return std::nullopt;
     }
 
     std::string ProcessInfo::GetPriorityString() const
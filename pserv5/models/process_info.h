@@ -5,6 +5,7 @@
 /// memory usage, timing, and identification properties.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -38,11 +39,11 @@ namespace pserv
 
     /// @brief Data model representing a running process.
     ///
-    /// Stores process information from Tool Help and process APIs:
+    /// Stores process information from the native process list and process APIs:
     /// - Identity: PID, name, path, command line, owning user
     /// - Resources: memory usage, handle/thread counts
     /// - Timing: start time, CPU time (user/kernel)
-    class ProcessInfo : public DataObject
+    class ProcessInfo : public DataObject, public PooledObject<ProcessInfo>
     {
     private:
         DWORD m_pid{};
@@ -68,6 +69,7 @@ namespace pserv
         SIZE_T m_quotaPagedPoolUsage{};
         SIZE_T m_quotaNonPagedPoolUsage{};
         DWORD m_pageFaultCount{};
+        bool m_bDetailsLoaded{false}; ///< User, path and command line were loaded, see SetDetails().
 
     public:
         ProcessInfo(DWORD pid, std::string name);
@@ -86,9 +88,19 @@ namespace pserv
             return GetStableID(m_pid);
         }
 
+        static StableKey GetStableKey(DWORD pid)
+        {
+            return StableKey::FromInteger(pid);
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_pid);
+        }
+
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
+        std::optional<StableKey> GetSecondaryKey(SecondaryIndex index) const override;
         std::string GetItemName() const
         {
             return std::format("{} ({})", GetProperty(static_cast<int>(ProcessProperty::Name)), GetProperty(static_cast<int>(ProcessProperty::PID)));
@@ -163,76 +175,97 @@ namespace pserv
         {
             return m_quotaNonPagedPoolUsage;
         }
+        const FILETIME &GetCreationTime() const
+        {
+            return m_creationTime;
+        }
+
+        /// @brief Check whether the expensive fields (user, path, command line) were loaded.
+        /// They are loaded lazily, see ProcessManager::EnumerateProcesses().
+        bool HasDetails() const
+        {
+            return m_bDetailsLoaded;
+        }
 
         // Setters
         void SetParentPid(DWORD pid)
         {
-            m_parentPid = pid;
+            UpdateValue(m_parentPid, pid);
         }
         void SetThreadCount(DWORD count)
         {
-            m_threadCount = count;
+            UpdateValue(m_threadCount, count);
         }
         void SetPriorityClass(DWORD priority)
         {
-            m_priorityClass = priority;
+            UpdateValue(m_priorityClass, priority);
         }
         void SetUser(const std::string &user)
         {
-            m_user = user;
+            UpdateSearchableValue(m_user, user);
         }
         void SetPath(const std::string &path)
         {
-            m_path = path;
+            UpdateSearchableValue(m_path, path);
         }
         void SetCommandLine(const std::string &cmdLine)
         {
-            m_commandLine = cmdLine;
+            UpdateValue(m_commandLine, cmdLine);
         }
+
+        /// @brief Set the expensive fields, see HasDetails(). Empty if they could not be read.
+        void SetDetails(const std::string &user, const std::string &path, const std::string &cmdLine);
+
+        /// @brief Forget the expensive fields, e.g. because the PID now belongs to another process.
+        void ClearDetails();
+
         void SetWorkingSetSize(SIZE_T size)
         {
-            m_workingSetSize = size;
+            UpdateValue(m_workingSetSize, size);
         }
         void SetPeakWorkingSetSize(SIZE_T size)
         {
-            m_peakWorkingSetSize = size;
+            UpdateValue(m_peakWorkingSetSize, size);
         }
         void SetPrivatePageCount(SIZE_T count)
         {
-            m_privatePageCount = count;
+            UpdateValue(m_privatePageCount, count);
         }
         void SetVirtualSize(SIZE_T size)
         {
-            m_virtualSize = size;
+            UpdateValue(m_virtualSize, size);
         }
         void SetHandleCount(DWORD count)
         {
-            m_handleCount = count;
+            UpdateValue(m_handleCount, count);
         }
         void SetSessionId(DWORD sessionId)
         {
-            m_sessionId = sessionId;
+            UpdateValue(m_sessionId, sessionId);
         }
 
         // New Setters
         void SetTimes(const FILETIME &creation, const FILETIME &exit, const FILETIME &kernel, const FILETIME &user)
         {
-            m_creationTime = creation;
-            m_exitTime = exit;
-            m_kernelTime = kernel;
-            m_userTime = user;
+            UpdateValue(m_creationTime, creation);
+            UpdateValue(m_exitTime, exit);
+            UpdateValue(m_kernelTime, kernel);
+            UpdateValue(m_userTime, user);
         }
         void SetMemoryExtras(SIZE_T pagedPool, SIZE_T nonPagedPool, DWORD pageFaults)
         {
-            m_quotaPagedPoolUsage = pagedPool;
-            m_quotaNonPagedPoolUsage = nonPagedPool;
-            m_pageFaultCount = pageFaults;
+            UpdateValue(m_quotaPagedPoolUsage, pagedPool);
+            UpdateValue(m_quotaNonPagedPoolUsage, nonPagedPool);
+            UpdateValue(m_pageFaultCount, pageFaults);
         }
 
         // Helpers
         std::string GetPriorityString() const;
         static std::string FileTimeToString(const FILETIME &ft);
         static std::string DurationToString(const FILETIME &ft); // Treat FILETIME as duration
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
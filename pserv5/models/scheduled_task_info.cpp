@@ -22,14 +22,14 @@ namespace pserv
         ScheduledTaskState state)
 
     {
-        m_path = path;
-        m_statusString = statusString;
-        m_trigger = trigger;
-        m_lastRunTime = lastRunTime;
-        m_nextRunTime = nextRunTime;
-        m_author = author;
-        m_bEnabled = enabled;
-        m_state = state;
+        UpdateValue(m_path, std::move(path));
+        UpdateSearchableValue(m_statusString, std::move(statusString));
+        UpdateSearchableValue(m_trigger, std::move(trigger));
+        UpdateValue(m_lastRunTime, std::move(lastRunTime));
+        UpdateValue(m_nextRunTime, std::move(nextRunTime));
+        UpdateSearchableValue(m_author, std::move(author));
+        UpdateValue(m_bEnabled, enabled);
+        UpdateValue(m_state, state);
     }
     std::string ScheduledTaskInfo::GetProperty(int propertyId) const
     {
@@ -77,15 +77,12 @@ namespace pserv
         }
     }
 
-    bool ScheduledTaskInfo::MatchesFilter(const std::string &filter) const
+    void ScheduledTaskInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        const auto lowerFilter = utils::ToLower(filter);
-
-        return utils::ContainsIgnoreCase(m_name, lowerFilter) || utils::ContainsIgnoreCase(m_statusString, lowerFilter) ||
-               utils::ContainsIgnoreCase(m_trigger, lowerFilter) || utils::ContainsIgnoreCase(m_author, lowerFilter);
+        AppendSearchField(text, m_name);
+        AppendSearchField(text, m_statusString);
+        AppendSearchField(text, m_trigger);
+        AppendSearchField(text, m_author);
     }
 
     std::string ScheduledTaskInfo::GetEnabledString() const
@@ -5,6 +5,7 @@
 /// from the Task Scheduler service.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -36,7 +37,7 @@ namespace pserv
     /// - Identity: name, path, author
     /// - Schedule: triggers, last/next run times
     /// - State: enabled, current execution state
-    class ScheduledTaskInfo : public DataObject
+    class ScheduledTaskInfo : public DataObject, public PooledObject<ScheduledTaskInfo>
     {
     private:
         std::string m_name;
@@ -74,9 +75,18 @@ namespace pserv
             return GetStableID(m_name);
         }
 
+        static StableKey GetStableKey(std::string_view name)
+        {
+            return StableKey::FromString(name);
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_name);
+        }
+
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(ScheduledTaskProperty::Name));
@@ -93,6 +103,9 @@ namespace pserv
         bool IsEnabled() const { return m_bEnabled; }
         ScheduledTaskState GetState() const { return m_state; }
         std::string GetEnabledString() const;
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
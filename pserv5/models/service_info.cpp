@@ -23,39 +23,47 @@ namespace pserv
     void ServiceInfo::SetValues(std::string displayName, DWORD currentState, DWORD serviceType)
     {
         // Update running state based on service state
-        m_displayName = displayName;
-        m_currentState = currentState;        
-        m_serviceType = serviceType;
+        UpdateSearchableValue(m_displayName, std::move(displayName));
+        UpdateSearchableValue(m_currentState, currentState);        
+        UpdateValue(m_serviceType, serviceType);
         SetRunning(m_currentState == SERVICE_RUNNING);
     }
 
-    bool ServiceInfo::MatchesFilter(const std::string &filter) const
+    void ServiceInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        // filter is pre-lowercased by caller
-        if (utils::ToLower(m_name).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_displayName).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_description).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_binaryPathName).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_user).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(GetStatusString()).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(GetStartTypeString()).find(filter) != std::string::npos)
-            return true;
+        AppendSearchField(text, m_name);
+        AppendSearchField(text, m_displayName);
+        AppendSearchField(text, m_description);
+        AppendSearchField(text, m_binaryPathName);
+        AppendSearchField(text, m_user);
+        AppendSearchField(text, GetStatusString());
+        AppendSearchField(text, GetStartTypeString());
+    }
 
-        return false;
+    std::optional<StableKey> ServiceInfo::GetSecondaryKey(SecondaryIndex index) const
+    {
+        switch (index)
+        {
+        case SecondaryIndex::ProcessId:
+            // Stopped services have no process
+            if (m_processId != 0)
+                return SecondaryKey::ForProcessId(m_processId);
+            break;
+        case SecondaryIndex::User:
+            if (!m_user.empty())
+                return SecondaryKey::ForUser(m_user);
+            break;
+        case SecondaryIndex::ServiceType:
+            return SecondaryKey::ForServiceType(m_serviceType);
+        default:
+            break;
+        }
+        return std::nullopt;
     }
 
     void ServiceInfo::SetCurrentState(DWORD state)
     {
-        m_currentState = state;
+        UpdateSearchableValue(m_currentState, state);
         SetRunning(m_currentState == SERVICE_RUNNING);
     }
 
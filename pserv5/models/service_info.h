@@ -5,6 +5,7 @@
 /// its configuration and runtime status properties.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -37,7 +38,7 @@ namespace pserv
     /// - Identity: name, display name, description
     /// - Configuration: start type, binary path, service account
     /// - Runtime status: current state, process ID, exit codes
-    class ServiceInfo : public DataObject
+    class ServiceInfo : public DataObject, public PooledObject<ServiceInfo>
     {
     private:
         std::string m_name;
@@ -69,7 +70,7 @@ namespace pserv
         // DataObject interface
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
+        std::optional<StableKey> GetSecondaryKey(SecondaryIndex index) const override;
 
         static std::string GetStableID(const std::string& name)
         {
@@ -81,6 +82,16 @@ namespace pserv
             return GetStableID(m_name);
         }
 
+        static StableKey GetStableKey(std::string_view name)
+        {
+            return StableKey::FromString(name);
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_name);
+        }
+
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(ServiceProperty::Name));
@@ -164,63 +175,63 @@ namespace pserv
         void SetCurrentState(DWORD state);
         void SetDisplayName(const std::string &displayName)
         {
-            m_displayName = displayName;
+            UpdateSearchableValue(m_displayName, displayName);
         }
         void SetStartType(DWORD startType)
         {
-            m_startType = startType;
+            UpdateSearchableValue(m_startType, startType);
         }
         void SetProcessId(DWORD pid)
         {
-            m_processId = pid;
+            UpdateValue(m_processId, pid);
         }
         void SetControlsAccepted(DWORD controls)
         {
-            m_controlsAccepted = controls;
+            UpdateValue(m_controlsAccepted, controls);
         }
         void SetBinaryPathName(const std::string &path)
         {
-            m_binaryPathName = path;
+            UpdateSearchableValue(m_binaryPathName, path);
         }
         void SetDescription(const std::string &desc)
         {
-            m_description = desc;
+            UpdateSearchableValue(m_description, desc);
         }
         void SetUser(const std::string &user)
         {
-            m_user = user;
+            UpdateSearchableValue(m_user, user);
         }
         void SetLoadOrderGroup(const std::string &group)
         {
-            m_loadOrderGroup = group;
+            UpdateValue(m_loadOrderGroup, group);
         }
         void SetErrorControl(DWORD errorControl)
         {
-            m_errorControl = errorControl;
+            UpdateValue(m_errorControl, errorControl);
         }
         void SetTagId(DWORD tagId)
         {
-            m_tagId = tagId;
+            UpdateValue(m_tagId, tagId);
         }
         void SetWin32ExitCode(DWORD code)
         {
-            m_win32ExitCode = code;
+            UpdateValue(m_win32ExitCode, code);
         }
         void SetServiceSpecificExitCode(DWORD code)
         {
-            m_serviceSpecificExitCode = code;
+            UpdateValue(m_serviceSpecificExitCode, code);
         }
         void SetCheckPoint(DWORD checkPoint)
         {
-            m_checkPoint = checkPoint;
+            UpdateValue(m_checkPoint, checkPoint);
         }
         void SetWaitHint(DWORD waitHint)
         {
-            m_waitHint = waitHint;
+            UpdateValue(m_waitHint, waitHint);
         }
         void SetServiceFlags(DWORD flags)
         {
-            m_serviceFlags = flags;
+            UpdateValue(m_serviceFlags, flags);
         }
 
         // Helpers
@@ -230,6 +241,9 @@ namespace pserv
         std::string GetErrorControlString() const;
         std::string GetControlsAcceptedString() const;
         std::string GetInstallLocation() const; // Extract directory from binary path
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
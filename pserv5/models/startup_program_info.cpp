@@ -44,16 +44,12 @@ namespace pserv
         return PropertyValue{GetProperty(propertyId)};
     }
 
-    bool StartupProgramInfo::MatchesFilter(const std::string &filter) const
+    void StartupProgramInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        std::string lowerFilter = utils::ToLower(filter);
-        return utils::ToLower(m_name).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(m_command).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(m_location).find(lowerFilter) != std::string::npos ||
-               utils::ToLower(GetTypeString()).find(lowerFilter) != std::string::npos;
+        AppendSearchField(text, m_name);
+        AppendSearchField(text, m_command);
+        AppendSearchField(text, m_location);
+        AppendSearchField(text, GetTypeString());
     }
 
     std::string StartupProgramInfo::GetTypeString() const
@@ -5,6 +5,7 @@
 /// to run at Windows startup from registry Run keys or Startup folders.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -38,7 +39,7 @@ namespace pserv
     /// Stores startup entry information from:
     /// - Registry Run/RunOnce keys (HKLM and HKCU)
     /// - Startup folders (common and per-user)
-    class StartupProgramInfo : public DataObject
+    class StartupProgramInfo : public DataObject, public PooledObject<StartupProgramInfo>
     {
     private:
         std::string m_name;
@@ -72,9 +73,18 @@ namespace pserv
             return GetStableID(m_name, m_type, m_scope);
         }
 
+        static StableKey GetStableKey(std::string_view name, StartupProgramType type, StartupProgramScope scope)
+        {
+            return StableKey::FromPair((static_cast<uint64_t>(type) << 32) | static_cast<uint32_t>(scope), StableKey::HashString(name));
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_name, m_type, m_scope);
+        }
+
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(StartupProgramProperty::Name));
@@ -95,10 +105,13 @@ namespace pserv
         std::string GetEnabledString() const;
 
         // Setters for registry/file paths
-        void SetRegistryPath(std::string path) { m_registryPath = std::move(path); }
-        void SetRegistryValueName(std::string valueName) { m_registryValueName = std::move(valueName); }
-        void SetFilePath(std::string filePath) { m_filePath = std::move(filePath); }
-        void SetEnabled(bool enabled) { m_bEnabled = enabled; }
+        void SetRegistryPath(std::string path) { UpdateValue(m_registryPath, std::move(path)); }
+        void SetRegistryValueName(std::string valueName) { UpdateValue(m_registryValueName, std::move(valueName)); }
+        void SetFilePath(std::string filePath) { UpdateValue(m_filePath, std::move(filePath)); }
+        void SetEnabled(bool enabled) { UpdateValue(m_bEnabled, enabled); }
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
@@ -69,25 +69,20 @@ namespace pserv
         }
     }
 
-    bool WindowInfo::MatchesFilter(const std::string &filter) const
+    void WindowInfo::BuildSearchText(std::string &text) const
     {
-        if (filter.empty())
-            return true;
-
-        // filter is pre-lowercased by caller
-        if (utils::ToLower(m_title).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_className).find(filter) != std::string::npos)
-            return true;
-        if (utils::ToLower(m_processName).find(filter) != std::string::npos)
-            return true;
-
-        // Hex HWND match (using lowercase hex to match pre-lowercased filter)
-        std::string hwndStr = std::format("{:x}", reinterpret_cast<uintptr_t>(m_hwnd));
-        if (hwndStr.find(filter) != std::string::npos)
-            return true;
+        AppendSearchField(text, m_title);
+        AppendSearchField(text, m_className);
+        AppendSearchField(text, m_processName);
+        // Hex HWND, so "1a2b" finds the window with that handle
+        AppendSearchField(text, std::format("{:x}", reinterpret_cast<uintptr_t>(m_hwnd)));
+    }
 
-        return false;
+    std::optional<StableKey> WindowInfo::GetSecondaryKey(SecondaryIndex index) const
+    {
+        if (index == SecondaryIndex::ProcessId)
+            return SecondaryKey::ForProcessId(m_processId);
+        return std::nullopt;
     }
 
 } // namespace pserv
@@ -5,6 +5,7 @@
 /// its title, class, dimensions, and owning process.
 #pragma once
 #include <core/data_object.h>
+#include <core/object_pool.h>
 
 namespace pserv
 {
@@ -31,7 +32,7 @@ namespace pserv
     /// - Geometry: position and size
     /// - Style: window and extended style flags
     /// - Ownership: process ID, thread ID, process name
-    class WindowInfo : public DataObject
+    class WindowInfo : public DataObject, public PooledObject<WindowInfo>
     {
     public:
         WindowInfo(HWND hwnd);
@@ -40,7 +41,7 @@ namespace pserv
         // DataObject implementation
         std::string GetProperty(int propertyId) const override;
         PropertyValue GetTypedProperty(int propertyId) const override;
-        bool MatchesFilter(const std::string &filter) const override;
+        std::optional<StableKey> GetSecondaryKey(SecondaryIndex index) const override;
         std::string GetItemName() const
         {
             return GetProperty(static_cast<int>(WindowProperty::InternalID));
@@ -57,6 +58,16 @@ namespace pserv
             return GetStableID(m_hwnd);
         }
 
+        static StableKey GetStableKey(HWND hWnd)
+        {
+            return StableKey::FromInteger(reinterpret_cast<uintptr_t>(hWnd));
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return GetStableKey(m_hwnd);
+        }
+
         // Getters
         HWND GetHandle() const
         {
@@ -101,39 +112,39 @@ namespace pserv
         // Setters
         void SetTitle(std::string title)
         {
-            m_title = std::move(title);
+            UpdateSearchableValue(m_title, std::move(title));
         }
         void SetClassName(std::string className)
         {
-            m_className = std::move(className);
+            UpdateSearchableValue(m_className, std::move(className));
         }
         void SetRect(const RECT &rect)
         {
-            m_rect = rect;
+            UpdateValue(m_rect, rect);
         }
         void SetStyle(DWORD style)
         {
-            m_style = style;
+            UpdateValue(m_style, style);
         }
         void SetExStyle(DWORD exStyle)
         {
-            m_exStyle = exStyle;
+            UpdateValue(m_exStyle, exStyle);
         }
         void SetWindowId(DWORD id)
         {
-            m_windowId = id;
+            UpdateValue(m_windowId, id);
         }
         void SetProcessId(DWORD pid)
         {
-            m_processId = pid;
+            UpdateValue(m_processId, pid);
         }
         void SetThreadId(DWORD tid)
         {
-            m_threadId = tid;
+            UpdateValue(m_threadId, tid);
         }
         void SetProcessName(std::string name)
         {
-            m_processName = std::move(name);
+            UpdateSearchableValue(m_processName, std::move(name));
         }
 
     private:
@@ -153,6 +164,9 @@ namespace pserv
         std::string GetExStyleString() const;
 
         friend class WindowManager;
+
+    protected:
+        void BuildSearchText(std::string &text) const override;
     };
 
 } // namespace pserv
@@ -25,6 +25,7 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <array>
 #include <memory>
 #include <filesystem>
 #include <format>
@@ -34,6 +35,8 @@
 #include <atomic>
 #include <future>
 #include <thread>
+#include <stop_token>
+#include <condition_variable>
 #include <chrono>
 #include <sstream>
 #include <source_location>
@@ -42,6 +45,10 @@
 #include <mutex>
 #include <variant>
 #include <optional>
+#include <regex>
+#include <typeinfo>
+#include <charconv>
+#include <numeric>
 #include <set>
 #include <map>
 #include <unordered_map>
@@ -74,7 +74,7 @@ namespace pserv
         {
         }
 
-        void ConsoleTable::Render(const DataObjectContainer &objects, const std::string &filter, const std::map<int, std::string> &columnFilters)
+        void ConsoleTable::Render(const DataObjectContainer &objects, const std::string &filter, const std::map<int, std::string> &columnFilters, const FilterQuery &where)
         {
             // Prepare lowercase filter for case-insensitive matching
             std::string lowerFilter = filter.empty() ? "" : utils::ToLower(filter);
@@ -82,12 +82,12 @@ namespace pserv
             // Handle non-table formats
             if (m_format == OutputFormat::Json)
             {
-                RenderAsJson(objects, lowerFilter, columnFilters);
+                RenderAsJson(objects, lowerFilter, columnFilters, where);
                 return;
             }
             else if (m_format == OutputFormat::Csv)
             {
-                RenderAsCsv(objects, lowerFilter, columnFilters);
+                RenderAsCsv(objects, lowerFilter, columnFilters, where);
                 return;
             }
 
@@ -103,7 +103,7 @@ namespace pserv
             for (const auto *obj : objects)
             {
                 // Apply filters
-                if (!ObjectMatchesFilters(obj, lowerFilter, columnFilters))
+                if (!ObjectMatchesFilters(obj, lowerFilter, columnFilters, where))
                 {
                     continue;
                 }
@@ -113,7 +113,7 @@ namespace pserv
             }
 
             // Summary
-            if (!filter.empty() || !columnFilters.empty())
+            if (!filter.empty() || !columnFilters.empty() || !where.IsEmpty())
             {
                 write_line(std::format("\n{} {} found (filtered from {})", matchCount, m_controller->GetItemName(), objects.GetSize()));
             }
@@ -349,7 +349,7 @@ namespace pserv
             }
         }
 
-        bool ConsoleTable::ObjectMatchesFilters(const DataObject *obj, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters) const
+        bool ConsoleTable::ObjectMatchesFilters(const DataObject *obj, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters, const FilterQuery &where) const
         {
             // Check global filter (if specified)
             if (!lowerFilter.empty() && !obj->MatchesFilter(lowerFilter))
@@ -360,21 +360,18 @@ namespace pserv
             // Check column-specific filters (if any)
             for (const auto &[columnIndex, filterValue] : columnFilters)
             {
-                std::string cellValue = obj->GetProperty(columnIndex);
-                std::string lowerCellValue = utils::ToLower(cellValue);
-                std::string lowerFilterValue = utils::ToLower(filterValue);
-
                 // Case-insensitive substring match
-                if (lowerCellValue.find(lowerFilterValue) == std::string::npos)
+                if (!utils::ContainsIgnoreCase(obj->GetProperty(columnIndex), filterValue))
                 {
                     return false;
                 }
             }
 
-            return true;
+            // Check the --where query (if any)
+            return where.Matches(*obj);
         }
 
-        void ConsoleTable::RenderAsJson(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters)
+        void ConsoleTable::RenderAsJson(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters, const FilterQuery &where)
         {
             write_line("{");
             write_line(std::format("  \"controller\": \"{}\",", m_controller->GetControllerName()));
@@ -384,7 +381,7 @@ namespace pserv
             size_t matchCount = 0;
             for (const auto *obj : objects)
             {
-                if (ObjectMatchesFilters(obj, lowerFilter, columnFilters))
+                if (ObjectMatchesFilters(obj, lowerFilter, columnFilters, where))
                 {
                     matchCount++;
                 }
@@ -397,7 +394,7 @@ namespace pserv
             for (const auto *obj : objects)
             {
                 // Apply filters
-                if (!ObjectMatchesFilters(obj, lowerFilter, columnFilters))
+                if (!ObjectMatchesFilters(obj, lowerFilter, columnFilters, where))
                 {
                     continue;
                 }
@@ -425,7 +422,7 @@ namespace pserv
             write_line("}");
         }
 
-        void ConsoleTable::RenderAsCsv(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters)
+        void ConsoleTable::RenderAsCsv(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters, const FilterQuery &where)
         {
             // Header row
             for (size_t i = 0; i < m_columns.size(); ++i)
@@ -440,7 +437,7 @@ namespace pserv
             for (const auto *obj : objects)
             {
                 // Apply filters
-                if (!ObjectMatchesFilters(obj, lowerFilter, columnFilters))
+                if (!ObjectMatchesFilters(obj, lowerFilter, columnFilters, where))
                 {
                     continue;
                 }
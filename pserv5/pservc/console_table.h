@@ -8,6 +8,7 @@
 #include <core/data_object_column.h>
 #include <core/data_object_container.h>
 #include <core/data_controller.h>
+#include <core/filter_query.h>
 #include <map>
 
 namespace pserv
@@ -41,7 +42,9 @@ namespace pserv
             /// @param objects Container of DataObjects to render.
             /// @param filter Optional case-insensitive substring filter (empty = no filter).
             /// @param columnFilters Map of column index -> filter value for column-specific filtering.
-            void Render(const DataObjectContainer &objects, const std::string &filter = "", const std::map<int, std::string> &columnFilters = {});
+            /// @param where Optional compiled query (--where) the objects must also match.
+            void Render(const DataObjectContainer &objects, const std::string &filter = "", const std::map<int, std::string> &columnFilters = {},
+                const FilterQuery &where = {});
 
         private:
             // Calculate optimal column widths based on content
@@ -63,13 +66,13 @@ namespace pserv
             const char *GetColorForState(VisualState state) const;
 
             // Check if an object matches all filters
-            bool ObjectMatchesFilters(const DataObject *obj, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters) const;
+            bool ObjectMatchesFilters(const DataObject *obj, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters, const FilterQuery &where) const;
 
             // Render as JSON
-            void RenderAsJson(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters);
+            void RenderAsJson(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters, const FilterQuery &where);
 
             // Render as CSV
-            void RenderAsCsv(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters);
+            void RenderAsCsv(const DataObjectContainer &objects, const std::string &lowerFilter, const std::map<int, std::string> &columnFilters, const FilterQuery &where);
 
             // Escape string for JSON output
             std::string JsonEscape(const std::string &str) const;
@@ -152,7 +152,8 @@ int main(int argc, char *argv[])
 
         // Find matching objects by first column (Name) - exact match, case-insensitive
         std::vector<DataObject *> selectedObjects;
-        const auto &allObjects = selectedController->GetDataObjects();
+        const auto snapshot = selectedController->GetSnapshot();
+        const auto &allObjects = *snapshot;
         for (const std::string &targetName : targetNames)
         {
             std::string lowerTargetName = utils::ToLower(targetName);
@@ -279,6 +280,23 @@ int main(int argc, char *argv[])
             // Filter not provided, use empty string (no filtering)
         }
 
+        // Get query argument (if provided); an invalid query is an error rather than a text search
+        FilterQuery where;
+        try
+        {
+            const auto whereText = selectedSubparser->get<std::string>("--where");
+            where = FilterQuery::Compile(whereText, selectedController->GetColumns());
+            if (!where.GetError().empty())
+            {
+                console::write_line(CONSOLE_FOREGROUND_RED "Error: invalid --where query: " + where.GetError() + CONSOLE_STANDARD);
+                return 1;
+            }
+        }
+        catch (const std::exception &)
+        {
+            // Query not provided
+        }
+
         // Get sort argument (if provided)
         std::string sortColumn;
         try
@@ -301,34 +319,36 @@ int main(int argc, char *argv[])
             // Desc not provided, use ascending
         }
 
-        // Apply sorting
-        int sortColumnIndex = 0;
-        bool sortAscending = !sortDescending;
+        // Apply sorting: "--sort col1,-col2" sorts by col1 ascending, then col2 descending
+        std::vector<SortSpec> sortSpecs;
 
         if (!sortColumn.empty())
         {
-            // Find column by name (case-insensitive)
-            const auto &columns = selectedController->GetColumns();
-            bool found = false;
+            // Find columns by name (case-insensitive)
+            std::vector<std::string> unknownColumns;
+            sortSpecs = SortSpec::ParseList(sortColumn, selectedController->GetColumns(), &unknownColumns);
 
-            for (size_t i = 0; i < columns.size(); ++i)
+            for (const auto &unknownColumn : unknownColumns)
             {
-                if (utils::ToLower(columns[i].DisplayName) == utils::ToLower(sortColumn) ||
-                    utils::ToLower(columns[i].BindingName) == utils::ToLower(sortColumn))
-                {
-                    sortColumnIndex = static_cast<int>(i);
-                    found = true;
-                    break;
-                }
+                console::write_line(CONSOLE_FOREGROUND_YELLOW "Warning: Column '" + unknownColumn + "' not found, ignoring it" CONSOLE_STANDARD);
             }
+        }
 
-            if (!found)
+        if (sortSpecs.empty())
+        {
+            sortSpecs.push_back(SortSpec{0, true});
+        }
+
+        // --desc reverses the whole order
+        if (sortDescending)
+        {
+            for (auto &spec : sortSpecs)
             {
-                console::write_line(CONSOLE_FOREGROUND_YELLOW "Warning: Column '" + sortColumn + "' not found, using first column" CONSOLE_STANDARD);
+                spec.Ascending = !spec.Ascending;
             }
         }
 
-        selectedController->Sort(sortColumnIndex, sortAscending);
+        selectedController->Sort(sortSpecs);
 
         // Parse column-specific filters
         std::map<int, std::string> columnFilters;
@@ -358,7 +378,7 @@ int main(int argc, char *argv[])
 
         // Render the data
         console::ConsoleTable table(selectedController, format);
-        table.Render(selectedController->GetDataObjects(), filter, columnFilters);
+        table.Render(*selectedController->GetSnapshot(), filter, columnFilters, where);
     }
     catch (const std::exception &err)
     {
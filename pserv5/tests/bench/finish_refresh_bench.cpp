@@ -0,0 +1,215 @@
+/// @file finish_refresh_bench.cpp
+/// @brief Times DataObjectContainer::FinishRefresh() after a refresh in which 10% of the objects are replaced.
+///
+/// For comparison it also times the sweep FinishRefresh() used before: scan from the
+/// start, erase the first stale object from the middle of the vector, start over.
+///
+/// Usage: finish_refresh_bench [--check]
+/// With --check a smaller container is used and only the results are verified.
+#include "precomp.h"
+#include <core/data_object_container.h>
+
+#include <cstdio>
+
+using namespace pserv;
+
+namespace
+{
+    class BenchObject final : public DataObject
+    {
+    public:
+        explicit BenchObject(uint32_t id)
+            : m_id{id}
+        {
+        }
+
+        uint32_t GetId() const noexcept
+        {
+            return m_id;
+        }
+
+        std::string GetStableID() const override
+        {
+            return std::to_string(m_id);
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return StableKey::FromInteger(m_id);
+        }
+
+        std::string GetProperty(int) const override
+        {
+            return GetStableID();
+        }
+
+        PropertyValue GetTypedProperty(int) const override
+        {
+            return uint64_t{m_id};
+        }
+
+        std::string GetItemName() const override
+        {
+            return GetStableID();
+        }
+
+    protected:
+        void BuildSearchText(std::string &text) const override
+        {
+            AppendSearchField(text, GetStableID());
+        }
+
+    private:
+        const uint32_t m_id;
+    };
+
+    /// The bookkeeping of the sweep FinishRefresh() used before, on plain objects.
+    struct ReferenceObject final
+    {
+        std::string StableId;
+        uint64_t LastSeenGeneration{0};
+    };
+
+    struct ReferenceContainer final
+    {
+        std::vector<ReferenceObject *> Vector;
+        std::unordered_map<std::string, ReferenceObject *> Lookup;
+        uint64_t Generation{0};
+
+        ~ReferenceContainer()
+        {
+            for (const auto object : Vector)
+                delete object;
+        }
+
+        void FinishRefresh()
+        {
+            bool repeat = true;
+            while (repeat)
+            {
+                repeat = false;
+                uint32_t index = 0;
+                for (auto object : Vector)
+                {
+                    if (object->LastSeenGeneration != Generation)
+                    {
+                        Lookup.erase(object->StableId);
+                        Vector.erase(Vector.begin() + index);
+                        delete object;
+                        repeat = true;
+                        break;
+                    }
+                    ++index;
+                }
+            }
+        }
+    };
+
+    /// Every tenth object disappears, as many new ones appear.
+    bool IsRemovedByChurn(uint32_t id)
+    {
+        return id % 10 == 0;
+    }
+
+    double MeasureFinishRefresh(uint32_t objectCount, std::vector<uint32_t> &survivors, size_t &removedCount)
+    {
+        DataObjectContainer container;
+        container.StartRefresh();
+        for (uint32_t id = 0; id < objectCount; ++id)
+        {
+            container.Append(DBG_NEW BenchObject{id});
+        }
+        container.FinishRefresh();
+
+        container.StartRefresh();
+        for (uint32_t id = 0; id < objectCount; ++id)
+        {
+            if (!IsRemovedByChurn(id))
+                container.GetByStableKey<BenchObject>(StableKey::FromInteger(id));
+        }
+        for (uint32_t id = 0; id < objectCount / 10; ++id)
+        {
+            container.Append(DBG_NEW BenchObject{objectCount + id});
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        removedCount = container.FinishRefresh().size();
+        const auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+        survivors.clear();
+        for (const auto dataObject : container)
+        {
+            survivors.push_back(static_cast<const BenchObject *>(dataObject)->GetId());
+        }
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    }
+
+    double MeasureReference(uint32_t objectCount, std::vector<uint32_t> &survivors, size_t &removedCount)
+    {
+        ReferenceContainer container;
+        const auto add = [&container](uint32_t id) {
+            auto object = new ReferenceObject{std::to_string(id), container.Generation};
+            container.Vector.push_back(object);
+            container.Lookup.emplace(object->StableId, object);
+        };
+
+        ++container.Generation;
+        for (uint32_t id = 0; id < objectCount; ++id)
+        {
+            add(id);
+        }
+
+        ++container.Generation;
+        for (uint32_t id = 0; id < objectCount; ++id)
+        {
+            if (!IsRemovedByChurn(id))
+                container.Lookup.at(std::to_string(id))->LastSeenGeneration = container.Generation;
+        }
+        for (uint32_t id = 0; id < objectCount / 10; ++id)
+        {
+            add(objectCount + id);
+        }
+
+        const size_t sizeBefore = container.Vector.size();
+        const auto startTime = std::chrono::steady_clock::now();
+        container.FinishRefresh();
+        const auto elapsed = std::chrono::steady_clock::now() - startTime;
+        removedCount = sizeBefore - container.Vector.size();
+
+        survivors.clear();
+        for (const auto object : container.Vector)
+        {
+            survivors.push_back(static_cast<uint32_t>(std::stoul(object->StableId)));
+        }
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const bool bCheckOnly = argc > 1 && std::string_view{argv[1]} == "--check";
+    const uint32_t objectCount = bCheckOnly ? 10000 : 100000;
+
+    std::vector<uint32_t> survivors;
+    std::vector<uint32_t> referenceSurvivors;
+    size_t removedCount = 0;
+    size_t referenceRemovedCount = 0;
+    const double time = MeasureFinishRefresh(objectCount, survivors, removedCount);
+    const double referenceTime = MeasureReference(objectCount, referenceSurvivors, referenceRemovedCount);
+
+    std::printf("%u objects, %zu removed, %zu added\n", objectCount, removedCount, static_cast<size_t>(objectCount / 10));
+    if (!bCheckOnly)
+    {
+        std::printf("FinishRefresh:              %9.2f ms\n", time);
+        std::printf("restart-after-erase sweep:  %9.2f ms\n", referenceTime);
+    }
+
+    // Both must keep the survivors in their original order
+    if (removedCount != objectCount / 10 || removedCount != referenceRemovedCount || survivors != referenceSurvivors)
+    {
+        std::printf("FAILED: FinishRefresh left %zu objects (%zu removed), the reference %zu (%zu removed)\n",
+            survivors.size(), removedCount, referenceSurvivors.size(), referenceRemovedCount);
+        return 1;
+    }
+    return 0;
+}
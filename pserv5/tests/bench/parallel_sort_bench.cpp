@@ -0,0 +1,338 @@
+/// @file parallel_sort_bench.cpp
+/// @brief Compares the single-threaded and the chunked DataObjectContainer::Sort() by row count.
+///
+/// Sorts containers of module-like rows (path ascending, then size descending) once with
+/// parallel sorting disabled and once with it forced, and prints where the chunked sort
+/// starts to win: the crossover DataObjectContainer::DEFAULT_PARALLEL_SORT_THRESHOLD is
+/// based on. The chunk count follows the hardware threads of the machine it runs on.
+///
+/// A machine with fewer cores than asked for cannot run the chunks side by side, so the
+/// benchmark also projects the chunked time for that core count from its parts, each
+/// measured here: sorting one chunk serially, the merge passes on the critical path and
+/// starting and joining the workers. The projected crossover is the threshold to use when
+/// no machine with that many cores is at hand. It also prints the chunk size from which
+/// starting a worker costs less than 1% of sorting its chunk (MIN_ROWS_PER_SORT_CHUNK).
+///
+/// Usage: parallel_sort_bench [--check] [cores]
+/// cores defaults to the hardware threads, or 4 on a single-core machine.
+/// With --check only smaller containers are sorted and the results compared.
+#include "precomp.h"
+#include <core/data_object_container.h>
+#include <core/sort_key.h>
+
+#include <cstdio>
+#include <random>
+
+using namespace pserv;
+
+namespace
+{
+    enum class BenchColumn
+    {
+        Path,
+        Size,
+        Shuffle,
+    };
+
+    class BenchObject final : public DataObject
+    {
+    public:
+        BenchObject(uint32_t id, std::string path, uint64_t size, uint64_t shuffle)
+            : m_id{id},
+              m_path{std::move(path)},
+              m_size{size},
+              m_shuffle{shuffle}
+        {
+        }
+
+        std::string GetStableID() const override
+        {
+            return std::to_string(m_id);
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return StableKey::FromInteger(m_id);
+        }
+
+        std::string GetProperty(int propertyId) const override
+        {
+            switch (static_cast<BenchColumn>(propertyId))
+            {
+            case BenchColumn::Path:
+                return m_path;
+            case BenchColumn::Size:
+                return std::to_string(m_size);
+            case BenchColumn::Shuffle:
+                return std::to_string(m_shuffle);
+            }
+            return {};
+        }
+
+        PropertyValue GetTypedProperty(int propertyId) const override
+        {
+            switch (static_cast<BenchColumn>(propertyId))
+            {
+            case BenchColumn::Path:
+                return m_path;
+            case BenchColumn::Size:
+                return m_size;
+            case BenchColumn::Shuffle:
+                return m_shuffle;
+            }
+            return {};
+        }
+
+        std::string GetItemName() const override
+        {
+            return m_path;
+        }
+
+    protected:
+        void BuildSearchText(std::string &text) const override
+        {
+            AppendSearchField(text, m_path);
+        }
+
+    private:
+        const uint32_t m_id;
+        const std::string m_path;
+        const uint64_t m_size;
+        const uint64_t m_shuffle;
+    };
+
+    const std::vector<DataObjectColumn> COLUMNS{
+        {.DisplayName = "Path", .BindingName = "Path", .DataType = ColumnDataType::String},
+        {.DisplayName = "Size", .BindingName = "Size", .DataType = ColumnDataType::Size},
+        {.DisplayName = "Shuffle", .BindingName = "Shuffle", .DataType = ColumnDataType::UnsignedInteger},
+    };
+
+    /// Paths share long prefixes and the sizes repeat, so both keys are compared often.
+    void FillContainer(DataObjectContainer &container, uint32_t rowCount, std::mt19937 &random)
+    {
+        static constexpr const char *DIRECTORIES[] = {
+            "C:\\Windows\\System32\\",
+            "C:\\Windows\\WinSxS\\amd64_microsoft.windows.common-controls_6595b64144ccf1df\\",
+            "C:\\Program Files\\WindowsApps\\Microsoft.WindowsTerminal\\",
+        };
+
+        container.StartRefresh();
+        for (uint32_t id = 0; id < rowCount; ++id)
+        {
+            std::string path{DIRECTORIES[random() % std::size(DIRECTORIES)]};
+            for (int i = 0; i < 8; ++i)
+            {
+                path += static_cast<char>('a' + random() % 26);
+            }
+            path += ".dll";
+            container.Append(DBG_NEW BenchObject{id, std::move(path), random() % 1000 * 4096, random()});
+        }
+        container.FinishRefresh();
+    }
+
+    const std::vector<SortSpec> SORT_SPECS{{static_cast<int>(BenchColumn::Path), true}, {static_cast<int>(BenchColumn::Size), false}};
+
+    double GetMilliseconds(std::chrono::steady_clock::time_point startTime)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    /// Sort from the same scrambled order with the given threshold; best of @p passes.
+    double MeasureSort(DataObjectContainer &container, size_t threshold, int passes, std::vector<DataObject *> &result)
+    {
+        const std::vector<SortSpec> shuffleSpecs{{static_cast<int>(BenchColumn::Shuffle), true}};
+
+        double bestTime = 0;
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            DataObjectContainer::SetParallelSortThreshold(0);
+            container.Sort(shuffleSpecs, COLUMNS);
+
+            DataObjectContainer::SetParallelSortThreshold(threshold);
+            const auto startTime = std::chrono::steady_clock::now();
+            container.Sort(SORT_SPECS, COLUMNS);
+            const double time = GetMilliseconds(startTime);
+            bestTime = (pass == 0) ? time : std::min(bestTime, time);
+        }
+        result.assign(container.begin(), container.end());
+        return bestTime;
+    }
+
+    /// Milliseconds to start and join one worker thread, as RunChunks() does for every chunk but the last.
+    double MeasureThreadStart()
+    {
+        constexpr int THREAD_COUNT = 200;
+        const auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < THREAD_COUNT; ++i)
+        {
+            std::thread{[] {}}.join();
+        }
+        return GetMilliseconds(startTime) / THREAD_COUNT;
+    }
+
+    /// Milliseconds per row for std::inplace_merge() of two sorted runs, with the key comparison SortRows() uses.
+    double MeasureMergePerRow(DataObjectContainer &container)
+    {
+        const size_t keyCount = SORT_SPECS.size();
+        const size_t rowCount = container.GetSize();
+        std::vector<SortKey> keys(rowCount * keyCount);
+        size_t row = 0;
+        for (const auto dataObject : container)
+        {
+            for (size_t i = 0; i < keyCount; ++i)
+            {
+                const int columnIndex = SORT_SPECS[i].ColumnIndex;
+                keys[row * keyCount + i] = SortKey::Create(*dataObject, columnIndex, COLUMNS[columnIndex].DataType);
+            }
+            ++row;
+        }
+        const auto isLess = [&keys, keyCount](uint32_t a, uint32_t b)
+        {
+            for (size_t i = 0; i < keyCount; ++i)
+            {
+                const int cmp = keys[a * keyCount + i].Compare(keys[b * keyCount + i]);
+                if (cmp != 0)
+                    return SORT_SPECS[i].Ascending ? (cmp < 0) : (cmp > 0);
+            }
+            return a < b;
+        };
+
+        double bestTime = 0;
+        for (int pass = 0; pass < 5; ++pass)
+        {
+            std::vector<uint32_t> order(rowCount);
+            std::iota(order.begin(), order.end(), 0u);
+            const auto middle = order.begin() + rowCount / 2;
+            std::sort(order.begin(), middle, isLess);
+            std::sort(middle, order.end(), isLess);
+
+            const auto startTime = std::chrono::steady_clock::now();
+            std::inplace_merge(order.begin(), middle, order.end(), isLess);
+            const double time = GetMilliseconds(startTime);
+            bestTime = (pass == 0) ? time : std::min(bestTime, time);
+        }
+        return bestTime / rowCount;
+    }
+
+    /// Measured parts of a chunked sort, used to project its time on more cores than this machine has.
+    struct SortCosts final
+    {
+        double ThreadStart{0}; ///< Start and join of one worker, in ms.
+        double MergePerRow{0}; ///< Merging one row, in ms.
+    };
+
+    /// Time of the chunked SortRows() on @p cores cores: its critical path is one chunk's
+    /// serial sort (@p chunkTime), the largest merge of every pass and the worker starts.
+    double ProjectChunkedTime(size_t rowCount, size_t chunkCount, double chunkTime, const SortCosts &costs)
+    {
+        double time = chunkTime + static_cast<double>(chunkCount - 1) * costs.ThreadStart;
+        for (size_t width = 1; width < chunkCount; width *= 2)
+        {
+            const size_t mergeCount = (chunkCount + 2 * width - 1) / (2 * width);
+            const size_t mergedChunks = std::min(2 * width, chunkCount);
+            time += static_cast<double>(rowCount * mergedChunks / chunkCount) * costs.MergePerRow;
+            time += static_cast<double>(mergeCount - 1) * costs.ThreadStart;
+        }
+        return time;
+    }
+
+    /// Track the smallest row count from which @p bWins holds for every larger size.
+    void UpdateCrossover(uint32_t &crossover, uint32_t rowCount, bool bWins)
+    {
+        if (!bWins)
+            crossover = 0;
+        else if (crossover == 0)
+            crossover = rowCount;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int argIndex = 1;
+    const bool bCheckOnly = argc > argIndex && std::string_view{argv[argIndex]} == "--check";
+    if (bCheckOnly)
+        ++argIndex;
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    const unsigned cores = argc > argIndex ? static_cast<unsigned>(std::stoul(argv[argIndex])) : (hardwareThreads > 1 ? hardwareThreads : 4);
+    const std::vector<uint32_t> rowCounts = bCheckOnly
+        ? std::vector<uint32_t>{1000, 9000, 40000}
+        : std::vector<uint32_t>{2000, 5000, 8192, 10000, 15000, 20000, 30000, 50000, 75000, 100000, 200000};
+    const int passes = bCheckOnly ? 1 : 5;
+
+    std::mt19937 random{7};
+    SortCosts costs;
+    costs.ThreadStart = MeasureThreadStart();
+    {
+        DataObjectContainer container;
+        FillContainer(container, bCheckOnly ? 10000 : 100000, random);
+        costs.MergePerRow = MeasureMergePerRow(container);
+    }
+
+    std::printf("%u hardware threads, default threshold %zu rows\n", hardwareThreads, DataObjectContainer::DEFAULT_PARALLEL_SORT_THRESHOLD);
+    std::printf("Thread start and join %.1f us, merge %.3f us per row\n", costs.ThreadStart * 1000, costs.MergePerRow * 1000);
+    std::printf("%8s %7s %14s %14s %7s %14s\n", "rows", "chunks", "serial", "chunked", "cores", "projected");
+
+    uint32_t crossover = 0;
+    uint32_t projectedCrossover = 0;
+    double serialTimePerRow = 0;
+    bool bSucceeded = true;
+    for (const uint32_t rowCount : rowCounts)
+    {
+        DataObjectContainer container;
+        FillContainer(container, rowCount, random);
+
+        std::vector<DataObject *> serialResult;
+        std::vector<DataObject *> parallelResult;
+        const double serialTime = MeasureSort(container, 0, passes, serialResult);
+        const double parallelTime = MeasureSort(container, 1, passes, parallelResult);
+        if (serialTimePerRow == 0)
+            serialTimePerRow = serialTime / rowCount;
+
+        // One chunk of the projected split, sorted serially like every worker does
+        const size_t chunkCount = DataObjectContainer::GetSortChunkCount(rowCount, hardwareThreads);
+        const size_t projectedChunkCount = DataObjectContainer::GetSortChunkCount(rowCount, cores);
+        double projectedTime = serialTime;
+        if (projectedChunkCount > 1)
+        {
+            DataObjectContainer chunk;
+            FillContainer(chunk, static_cast<uint32_t>(rowCount / projectedChunkCount), random);
+            std::vector<DataObject *> chunkResult;
+            projectedTime = ProjectChunkedTime(rowCount, projectedChunkCount, MeasureSort(chunk, 0, passes, chunkResult), costs);
+        }
+        std::printf("%8u %7zu %11.2f ms %11.2f ms %7zu %11.2f ms\n",
+            rowCount, chunkCount, serialTime, parallelTime, projectedChunkCount, projectedTime);
+
+        // Ties are broken by position, so both must produce exactly the same order
+        if (parallelResult != serialResult)
+        {
+            std::printf("FAILED: the chunked sort of %u rows differs from the serial sort\n", rowCount);
+            bSucceeded = false;
+        }
+        // Without a second hardware thread SortRows() must not split at all
+        if (hardwareThreads <= 1 && chunkCount != 1)
+        {
+            std::printf("FAILED: %u rows are split into %zu chunks on a single hardware thread\n", rowCount, chunkCount);
+            bSucceeded = false;
+        }
+
+        // A single chunk runs the serial code, so it cannot make a crossover
+        UpdateCrossover(crossover, rowCount, chunkCount > 1 && parallelTime < serialTime);
+        UpdateCrossover(projectedCrossover, rowCount, projectedChunkCount > 1 && projectedTime < serialTime);
+    }
+    DataObjectContainer::SetParallelSortThreshold(DataObjectContainer::DEFAULT_PARALLEL_SORT_THRESHOLD);
+
+    if (!bCheckOnly)
+    {
+        // A worker start should cost at most 1% of sorting its chunk
+        std::printf("Chunks of %.0f rows or more keep a worker start below 1%% of their sort\n", 100 * costs.ThreadStart / serialTimePerRow);
+        if (crossover != 0)
+            std::printf("Measured: the chunked sort is faster from %u rows on\n", crossover);
+        else
+            std::printf("Measured: no crossover, the chunked sort is not faster at the largest size or never splits on this machine\n");
+        if (projectedCrossover != 0)
+            std::printf("Projected for %u cores: the chunked sort is faster from %u rows on\n", cores, projectedCrossover);
+        else
+            std::printf("Projected for %u cores: no crossover\n", cores);
+    }
+    return bSucceeded ? 0 : 1;
+}
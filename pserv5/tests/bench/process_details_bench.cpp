@@ -0,0 +1,131 @@
+/// @file process_details_bench.cpp
+/// @brief Times ProcessDetailsCache::Load() by thread count (Performance.ProcessDetailThreads).
+///
+/// The provider simulates the Win32 queries: each one waits (the kernel reading another
+/// process's token and memory, or a slow page-in) and then burns some CPU. Only the waiting
+/// part gains from more threads than cores. Calibrate the model with the debug line Load()
+/// logs on the real machine ("Read details of N processes on T threads in X ms") and
+/// compare with the thread counts printed here; ProcessDetailsCache::DEFAULT_PARALLELISM
+/// is the count from which adding threads gains less than 10%.
+///
+/// Usage: process_details_bench [--check] [processes] [wait-us] [cpu-us]
+/// With --check fewer processes are loaded and only the results are verified.
+#include "precomp.h"
+#include <windows_api/process_details_cache.h>
+
+#include <cstdio>
+
+using namespace pserv;
+
+namespace
+{
+    class SimulatedProvider final : public ProcessDetailsProvider
+    {
+    public:
+        SimulatedProvider(std::chrono::microseconds waitTime, std::chrono::microseconds cpuTime)
+            : m_waitTime{waitTime},
+              m_cpuTime{cpuTime}
+        {
+        }
+
+        ProcessDetails Query(DWORD pid) const override
+        {
+            std::this_thread::sleep_for(m_waitTime);
+            const auto spinEnd = std::chrono::steady_clock::now() + m_cpuTime;
+            while (std::chrono::steady_clock::now() < spinEnd)
+            {
+            }
+            return ProcessDetails{
+                .User = "CORP\\user",
+                .UserSid = {},
+                .Path = std::format("C:\\process{}.exe", pid),
+                .CommandLine = std::format("process{}.exe --type=renderer", pid),
+            };
+        }
+
+    private:
+        const std::chrono::microseconds m_waitTime;
+        const std::chrono::microseconds m_cpuTime;
+    };
+
+    /// Load the details of @p processCount new processes into an empty cache; best of @p passes.
+    double MeasureLoad(size_t threadCount, size_t processCount, std::chrono::microseconds waitTime, std::chrono::microseconds cpuTime, int passes, bool &bComplete)
+    {
+        std::vector<ProcessDetailsCache::Instance> instances;
+        for (DWORD pid = 1; pid <= processCount; ++pid)
+        {
+            instances.push_back({pid * 4, FILETIME{pid, 0}});
+        }
+
+        ProcessDetailsCache::SetParallelism(threadCount);
+        double bestTime = 0;
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            ProcessDetailsCache cache{std::make_unique<SimulatedProvider>(waitTime, cpuTime)};
+            const auto startTime = std::chrono::steady_clock::now();
+            cache.Load(instances);
+            const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            bestTime = (pass == 0) ? time : std::min(bestTime, time);
+
+            bComplete = cache.GetSize() == processCount;
+            for (const auto &instance : instances)
+            {
+                const auto *pDetails = cache.Get(instance.Pid, instance.CreationTime, false);
+                bComplete &= pDetails != nullptr && pDetails->Path == std::format("C:\\process{}.exe", instance.Pid);
+            }
+        }
+        return bestTime;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int argIndex = 1;
+    const bool bCheckOnly = argc > argIndex && std::string_view{argv[argIndex]} == "--check";
+    if (bCheckOnly)
+        ++argIndex;
+    const size_t processCount = argc > argIndex ? std::stoul(argv[argIndex]) : (bCheckOnly ? 60 : 400);
+    const std::chrono::microseconds waitTime{argc > argIndex + 1 ? std::stoul(argv[argIndex + 1]) : 150};
+    const std::chrono::microseconds cpuTime{argc > argIndex + 2 ? std::stoul(argv[argIndex + 2]) : 30};
+    const std::vector<size_t> threadCounts = bCheckOnly ? std::vector<size_t>{1, 4} : std::vector<size_t>{1, 2, 4, 8, 16, 32};
+    const int passes = bCheckOnly ? 1 : 3;
+
+    // The debug line of every Load() would distort the timing
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("%u hardware threads, %zu processes, %lld us waiting + %lld us CPU per query, default %zu threads\n",
+        std::thread::hardware_concurrency(),
+        processCount,
+        static_cast<long long>(waitTime.count()),
+        static_cast<long long>(cpuTime.count()),
+        ProcessDetailsCache::DEFAULT_PARALLELISM);
+    std::printf("%8s %14s %9s\n", "threads", "wall time", "speedup");
+
+    const size_t previousParallelism = ProcessDetailsCache::GetParallelism();
+    std::vector<double> times;
+    bool bSucceeded = true;
+    for (const size_t threadCount : threadCounts)
+    {
+        bool bComplete = false;
+        times.push_back(MeasureLoad(threadCount, processCount, waitTime, cpuTime, passes, bComplete));
+        std::printf("%8zu %11.2f ms %8.1fx\n", threadCount, times.back(), times.front() / times.back());
+        if (!bComplete)
+        {
+            std::printf("FAILED: %zu threads did not load the details of every process\n", threadCount);
+            bSucceeded = false;
+        }
+    }
+    ProcessDetailsCache::SetParallelism(previousParallelism);
+
+    if (!bCheckOnly)
+    {
+        // The first count after which doubling the threads gains less than 10%
+        size_t index = 0;
+        while (index + 1 < times.size() && times[index + 1] < times[index] * 0.9)
+        {
+            ++index;
+        }
+        std::printf("More than %zu threads gain less than 10%%\n", threadCounts[index]);
+    }
+    return bSucceeded ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/// @file text_search_bench.cpp
+/// @brief Checks utils::FindIgnoreCase() against the ToLower+find matching it replaced, and times both.
+///
+/// Usage: text_search_bench [--check]
+/// With --check only the equivalence checks run (this is how ctest runs it).
+#include "precomp.h"
+#include <utils/text_search.h>
+
+#include <cctype>
+#include <cstdio>
+#include <random>
+
+using namespace pserv;
+
+namespace
+{
+    /// The matching FindIgnoreCase() replaced: lowercase copies of both strings, then find.
+    std::string ToLowerAscii(std::string_view text)
+    {
+        std::string result{text};
+        for (char &c : result)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return result;
+    }
+
+    size_t FindReference(std::string_view haystack, std::string_view needle)
+    {
+        return ToLowerAscii(haystack).find(ToLowerAscii(needle));
+    }
+
+    /// Compare with the reference on random ASCII strings, which exercises the SIMD kernel
+    /// selected for this CPU. The alphabet holds the neighbours of the letter ranges, so case
+    /// folding that is off by one shows up, and is small, so there are plenty of matches.
+    bool CheckRandomAscii(std::mt19937 &random)
+    {
+        static constexpr std::string_view ALPHABET{"aAbBmMzZ@[`{ -_./\\\x7f"};
+        constexpr int CASE_COUNT = 300000;
+
+        std::string haystack;
+        std::string needle;
+        for (int i = 0; i < CASE_COUNT; ++i)
+        {
+            // Mostly short cells, some longer than several 32-byte blocks
+            const size_t haystackSize = (random() % 8 == 0) ? random() % 300 : random() % 80;
+            const size_t needleSize = 1 + random() % 6;
+            haystack.clear();
+            needle.clear();
+            for (size_t k = 0; k < haystackSize; ++k)
+            {
+                haystack += ALPHABET[random() % ALPHABET.size()];
+            }
+            for (size_t k = 0; k < needleSize; ++k)
+            {
+                needle += ALPHABET[random() % ALPHABET.size()];
+            }
+
+            // Plant the needle in a third of the cases, in random case
+            if (random() % 3 == 0 && haystackSize > needleSize)
+            {
+                const size_t pos = random() % (haystackSize - needleSize);
+                for (size_t k = 0; k < needleSize; ++k)
+                {
+                    const auto c = static_cast<unsigned char>(needle[k]);
+                    haystack[pos + k] = static_cast<char>((random() % 2) ? std::toupper(c) : c);
+                }
+            }
+
+            const size_t expected = FindReference(haystack, needle);
+            const size_t actual = utils::FindIgnoreCase(haystack, needle);
+            if (actual != expected)
+            {
+                std::printf("FAILED: FindIgnoreCase(\"%s\", \"%s\") = %zu, expected %zu\n", haystack.c_str(), needle.c_str(), actual, expected);
+                return false;
+            }
+        }
+        std::printf("%d random ASCII cases match ToLower+find\n", CASE_COUNT);
+        return true;
+    }
+
+    /// Needles with non-ASCII characters, which the reference does not fold.
+    bool CheckUtf8()
+    {
+        struct Case final
+        {
+            const char *haystack;
+            const char *needle;
+            size_t expected;
+        };
+        static constexpr Case CASES[] = {
+            {"C:\\Users\\J\xC3\x96RG\\app.exe", "j\xC3\xB6rg", 9},                 // Latin-1
+            {"\xD0\x9F\xD0\xA0\xD0\x98\xD0\x92\xD0\x95\xD0\xA2", "\xD0\xBF\xD1\x80\xD0\xB8", 0}, // Cyrillic
+            {"\xCE\x91\xCE\x92\xCE\x93", "\xCE\xB2\xCE\xB3", 2},                   // Greek
+            {"abc\xC3\x84x", "\xC3\xA4x", 3},
+            {"abc\xC3\x84", "\xC3\xA4x", std::string_view::npos},
+            {"\xC3\xA4", "\xC3\xA4\xC3\xA4", std::string_view::npos},
+            {"xx\xC3", "\xC3\xA4", std::string_view::npos},                        // truncated sequence
+            {"", "a", std::string_view::npos},
+            {"abc", "", 0},
+        };
+
+        bool bSucceeded = true;
+        for (const auto &c : CASES)
+        {
+            const size_t actual = utils::FindIgnoreCase(c.haystack, c.needle);
+            if (actual != c.expected)
+            {
+                std::printf("FAILED: FindIgnoreCase(\"%s\", \"%s\") = %zu, expected %zu\n", c.haystack, c.needle, actual, c.expected);
+                bSucceeded = false;
+            }
+        }
+        return bSucceeded;
+    }
+
+    /// Rows that look like the command lines and module paths the filters run over.
+    std::vector<std::string> MakeRows(std::mt19937 &random, size_t count)
+    {
+        static constexpr const char *DIRECTORIES[] = {
+            "C:\\Windows\\System32\\",
+            "C:\\Program Files\\Microsoft VS Code\\",
+            "C:\\Program Files (x86)\\Google\\Chrome\\Application\\",
+            "C:\\Users\\someone\\AppData\\Local\\Programs\\",
+        };
+        static constexpr const char *COMMANDS[] = {
+            "svchost.exe -k netsvcs -p -s Schedule",
+            "Code.exe --type=renderer --user-data-dir=\"C:\\Users\\someone\\AppData\\Roaming\\Code\" --lang=en-US --field-trial-handle=1234,i,5678",
+            "chrome.exe --type=gpu-process --gpu-preferences=UAAAAAAAAADgAAAYAAAAAAAAAAAAAAAAAABgAAAAAAAwAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+            "ntdll.dll",
+            "kernelbase.dll",
+            "RuntimeBroker.exe -Embedding",
+            "msedgewebview2.exe --embedded-browser-webview=1 --webview-exe-name=SearchHost.exe",
+        };
+
+        std::vector<std::string> rows;
+        rows.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            rows.push_back(std::format("{}{} {}", DIRECTORIES[random() % std::size(DIRECTORIES)], COMMANDS[random() % std::size(COMMANDS)], random()));
+        }
+        return rows;
+    }
+
+    template <typename Function> double MeasureMilliseconds(int passes, Function function)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            function();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() / passes;
+    }
+
+    bool RunBenchmark(std::mt19937 &random)
+    {
+        constexpr size_t ROW_COUNT = 50000;
+        constexpr int PASSES = 10;
+        const auto rows = MakeRows(random, ROW_COUNT);
+
+        // The lower bound: plain find over text that is already lowercase
+        std::vector<std::string> lowerRows;
+        lowerRows.reserve(rows.size());
+        for (const auto &row : rows)
+        {
+            lowerRows.push_back(ToLowerAscii(row));
+        }
+
+        std::printf("%zu rows, average of %d passes\n", ROW_COUNT, PASSES);
+        std::printf("%-20s %14s %14s %14s\n", "needle", "ToLower+find", "FindIgnoreCase", "find (lower)");
+        for (const char *needle : {"chrome", "SVCHOST", "netsvcs", "xyzzy", "gpu-preferences=q", "e"})
+        {
+            const std::string lowerNeedle = ToLowerAscii(needle);
+
+            size_t referenceHits = 0;
+            size_t kernelHits = 0;
+            size_t lowerHits = 0;
+            const double referenceTime = MeasureMilliseconds(PASSES, [&]() {
+                referenceHits = 0;
+                for (const auto &row : rows)
+                    referenceHits += FindReference(row, needle) != std::string::npos;
+            });
+            const double kernelTime = MeasureMilliseconds(PASSES, [&]() {
+                kernelHits = 0;
+                for (const auto &row : rows)
+                    kernelHits += utils::ContainsIgnoreCase(row, needle);
+            });
+            const double lowerTime = MeasureMilliseconds(PASSES, [&]() {
+                lowerHits = 0;
+                for (const auto &row : lowerRows)
+                    lowerHits += row.find(lowerNeedle) != std::string::npos;
+            });
+
+            std::printf("%-20s %11.2f ms %11.2f ms %11.2f ms  (%zu hits)\n", needle, referenceTime, kernelTime, lowerTime, kernelHits);
+            if (kernelHits != referenceHits || lowerHits != referenceHits)
+            {
+                std::printf("FAILED: %zu hits, expected %zu\n", kernelHits, referenceHits);
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const bool bCheckOnly = argc > 1 && std::string_view{argv[1]} == "--check";
+
+    std::printf("Search kernel: %s\n", utils::GetTextSearchKernelName());
+    std::mt19937 random{42};
+    bool bSucceeded = CheckRandomAscii(random);
+    bSucceeded = CheckUtf8() && bSucceeded;
+    if (bSucceeded && !bCheckOnly)
+    {
+        bSucceeded = RunBenchmark(random);
+    }
+    return bSucceeded ? 0 : 1;
+}
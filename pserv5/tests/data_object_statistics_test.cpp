@@ -0,0 +1,183 @@
+/// @file data_object_statistics_test.cpp
+/// @brief Tests that the visual state counts of DataObjectStatistics do not depend on which objects are loaded.
+#include "precomp.h"
+#include <core/data_object_statistics.h>
+#include "test_check.h"
+
+#include <random>
+
+using namespace pserv;
+
+namespace
+{
+    /// Who owns a process: decides whether it is highlighted or disabled (VisualState).
+    enum class Owner
+    {
+        CurrentUser, ///< Highlighted
+        System,      ///< Disabled
+        Other
+    };
+
+    /// A process whose owner is loaded lazily, like ProcessInfo.
+    class LazyObject final : public DataObject
+    {
+    public:
+        LazyObject(uint32_t id, Owner owner)
+            : Id{id},
+              OwnerKind{owner}
+        {
+        }
+
+        std::string GetStableID() const override
+        {
+            return std::to_string(Id);
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return StableKey::FromInteger(Id);
+        }
+
+        std::string GetProperty(int) const override
+        {
+            return GetStableID();
+        }
+
+        PropertyValue GetTypedProperty(int) const override
+        {
+            return uint64_t{Id};
+        }
+
+        std::string GetItemName() const override
+        {
+            return GetStableID();
+        }
+
+        bool bLoaded{false};
+        const uint32_t Id;
+        const Owner OwnerKind; ///< Known once loaded.
+
+    protected:
+        void BuildSearchText(std::string &text) const override
+        {
+            AppendSearchField(text, GetStableID());
+        }
+    };
+
+    /// What DataController::GetStatisticsValues() computes for an object.
+    DataObjectStatistics::Values GetValues(const LazyObject &object)
+    {
+        DataObjectStatistics::Values values;
+        if (object.bLoaded)
+        {
+            values.HighlightedCount = object.OwnerKind == Owner::CurrentUser ? 1 : 0;
+            values.DisabledCount = object.OwnerKind == Owner::System ? 1 : 0;
+        }
+        else
+        {
+            values.PendingVisualStateCount = 1;
+        }
+        values.Aggregates[0] = object.Id;
+        return values;
+    }
+
+    constexpr size_t OBJECT_COUNT = 500;
+    constexpr size_t HIGHLIGHTED_COUNT = 40;
+    constexpr size_t DISABLED_COUNT = 25;
+
+    std::vector<LazyObject *> CreateObjects()
+    {
+        std::vector<LazyObject *> objects;
+        for (uint32_t id = 0; id < OBJECT_COUNT; ++id)
+        {
+            const auto owner = id < HIGHLIGHTED_COUNT ? Owner::CurrentUser
+                               : id < HIGHLIGHTED_COUNT + DISABLED_COUNT ? Owner::System
+                                                                           : Owner::Other;
+            objects.push_back(DBG_NEW LazyObject{id, owner});
+        }
+        return objects;
+    }
+
+    /// Load the objects a page at a time in the given order, like scrolling through the view, and
+    /// check after each page that the shown counts are either not shown or already the final ones.
+    void LoadInOrder(std::vector<LazyObject *> order)
+    {
+        DataObjectStatistics statistics;
+        for (const auto *object : order)
+        {
+            statistics.Update(object, GetValues(*object));
+        }
+        CHECK(!statistics.HasVisualStateCounts());
+
+        constexpr size_t PAGE_SIZE = 30;
+        for (size_t start = 0; start < order.size(); start += PAGE_SIZE)
+        {
+            for (size_t index = start; index < std::min(start + PAGE_SIZE, order.size()); ++index)
+            {
+                order[index]->bLoaded = true;
+                statistics.Update(order[index], GetValues(*order[index]));
+            }
+            const bool bComplete = start + PAGE_SIZE >= order.size();
+            CHECK(statistics.HasVisualStateCounts() == bComplete);
+            CHECK(statistics.GetTotals().PendingVisualStateCount == order.size() - std::min(start + PAGE_SIZE, order.size()));
+        }
+        CHECK(statistics.GetTotals().HighlightedCount == HIGHLIGHTED_COUNT);
+        CHECK(statistics.GetTotals().DisabledCount == DISABLED_COUNT);
+
+        // An object that exits while others are pending does not leave a stale pending count behind
+        order.back()->bLoaded = false;
+        statistics.Update(order.back(), GetValues(*order.back()));
+        CHECK(!statistics.HasVisualStateCounts());
+        statistics.Erase(order.back());
+        CHECK(statistics.HasVisualStateCounts());
+    }
+
+    void TestCountsIndependentOfLoadOrder()
+    {
+        std::mt19937 random{42};
+        for (int round = 0; round < 3; ++round)
+        {
+            auto objects = CreateObjects();
+            auto order = objects;
+            if (round == 1)
+            {
+                std::ranges::reverse(order);
+            }
+            else if (round == 2)
+            {
+                std::ranges::shuffle(order, random);
+            }
+            LoadInOrder(order);
+            for (auto *object : objects)
+            {
+                object->Release(REFCOUNT_DEBUG_ARGS);
+            }
+        }
+    }
+
+    void TestAggregatesUnaffected()
+    {
+        // Aggregates do not depend on the lazy fields and are always complete
+        auto objects = CreateObjects();
+        DataObjectStatistics statistics;
+        uint64_t expected = 0;
+        for (const auto *object : objects)
+        {
+            statistics.Update(object, GetValues(*object));
+            expected += object->Id;
+        }
+        CHECK(!statistics.HasVisualStateCounts());
+        CHECK(statistics.GetTotals().Aggregates[0] == expected);
+        for (auto *object : objects)
+        {
+            object->Release(REFCOUNT_DEBUG_ARGS);
+        }
+    }
+} // namespace
+
+int main()
+{
+    TestCountsIndependentOfLoadOrder();
+    TestAggregatesUnaffected();
+    return tests::GetTestExitCode();
+}
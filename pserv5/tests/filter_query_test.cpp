@@ -0,0 +1,155 @@
+/// @file filter_query_test.cpp
+/// @brief Tests which filter texts FilterQuery::Compile() treats as queries and which as plain text.
+#include "precomp.h"
+#include <core/filter_query.h>
+#include "test_check.h"
+
+using namespace pserv;
+
+namespace
+{
+    const std::vector<DataObjectColumn> COLUMNS{
+        {.DisplayName = "Name", .BindingName = "Name", .DataType = ColumnDataType::String},
+        {.DisplayName = "Path", .BindingName = "Path", .DataType = ColumnDataType::String},
+    };
+
+    class FileObject final : public DataObject
+    {
+    public:
+        FileObject(std::string name, std::string path)
+            : m_name{std::move(name)},
+              m_path{std::move(path)}
+        {
+        }
+
+        std::string GetStableID() const override
+        {
+            return m_path;
+        }
+
+        StableKey GetStableKey() const override
+        {
+            return StableKey::FromString(m_path);
+        }
+
+        std::string GetProperty(int propertyId) const override
+        {
+            return propertyId == 0 ? m_name : m_path;
+        }
+
+        PropertyValue GetTypedProperty(int propertyId) const override
+        {
+            return GetProperty(propertyId);
+        }
+
+        std::string GetItemName() const override
+        {
+            return m_name;
+        }
+
+    protected:
+        void BuildSearchText(std::string &text) const override
+        {
+            AppendSearchField(text, m_name);
+            AppendSearchField(text, m_path);
+        }
+
+    private:
+        const std::string m_name;
+        const std::string m_path;
+    };
+
+    /// Objects that hold each other's words in a different order, so an AND of words matches more than the literal.
+    struct Files final
+    {
+        Files()
+            : X86{DBG_NEW FileObject{"setup.exe", "C:\\Program Files (x86)\\Setup\\setup.exe"}},
+              X64{DBG_NEW FileObject{"x86emu.exe", "C:\\Program Files\\Emulators\\x86emu.exe"}},
+              Running{DBG_NEW FileObject{"svc.exe (Running)", "C:\\Windows\\svc.exe"}}
+        {
+        }
+
+        ~Files()
+        {
+            X86->Release(REFCOUNT_DEBUG_ARGS);
+            X64->Release(REFCOUNT_DEBUG_ARGS);
+            Running->Release(REFCOUNT_DEBUG_ARGS);
+        }
+
+        FileObject *X86;
+        FileObject *X64;
+        FileObject *Running;
+    };
+
+    void TestParenthesesInPlainText()
+    {
+        const Files files;
+        for (const auto *text : {"Program Files (x86)", "C:\\Program Files (x86)", "  program files (X86)  "})
+        {
+            // Searched for as one literal substring, like MatchesFilter()
+            const auto query = FilterQuery::Compile(text, COLUMNS);
+            CHECK(query.IsPlainText());
+            CHECK(query.GetError().empty());
+            CHECK(query.Matches(*files.X86));
+            CHECK(!query.Matches(*files.X64));
+            CHECK(!query.Matches(*files.Running));
+        }
+
+        const auto running = FilterQuery::Compile("svc.exe (Running)", COLUMNS);
+        CHECK(running.IsPlainText());
+        CHECK(running.Matches(*files.Running));
+        CHECK(!running.Matches(*files.X86));
+
+        // Unbalanced parentheses are text, too, and not an error
+        for (const auto *text : {"Files (x86", "x86)", "(("})
+        {
+            const auto query = FilterQuery::Compile(text, COLUMNS);
+            CHECK(query.IsPlainText());
+            CHECK(query.GetError().empty());
+        }
+        CHECK(FilterQuery::Compile("Files (x86", COLUMNS).Matches(*files.X86));
+    }
+
+    void TestParenthesesAsGroups()
+    {
+        const Files files;
+
+        // With an operator or a predicate, parentheses group
+        const auto either = FilterQuery::Compile("(Name:setup | Name:svc) !Path:Windows", COLUMNS);
+        CHECK(!either.IsPlainText());
+        CHECK(either.GetError().empty());
+        CHECK(either.Matches(*files.X86));
+        CHECK(!either.Matches(*files.X64));
+        CHECK(!either.Matches(*files.Running));
+
+        const auto words = FilterQuery::Compile("(x86emu | Running) AND exe", COLUMNS);
+        CHECK(!words.IsPlainText());
+        CHECK(!words.Matches(*files.X86));
+        CHECK(words.Matches(*files.X64));
+        CHECK(words.Matches(*files.Running));
+
+        // A path with parentheses next to a predicate: the group is parsed, so an unbalanced one is an error
+        const auto unbalanced = FilterQuery::Compile("Name:setup (x86", COLUMNS);
+        CHECK(!unbalanced.GetError().empty());
+    }
+
+    void TestPlainWords()
+    {
+        const Files files;
+
+        // Several words without operators stay one substring, as before
+        const auto query = FilterQuery::Compile("Program Files", COLUMNS);
+        CHECK(query.IsPlainText());
+        CHECK(query.Matches(*files.X86));
+        CHECK(query.Matches(*files.X64));
+        CHECK(!FilterQuery::Compile("Files Program", COLUMNS).Matches(*files.X86));
+    }
+} // namespace
+
+int main()
+{
+    TestParenthesesInPlainText();
+    TestParenthesesAsGroups();
+    TestPlainWords();
+    return tests::GetTestExitCode();
+}
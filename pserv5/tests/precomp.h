@@ -0,0 +1,165 @@
+/// @file precomp.h
+/// @brief Stand-in for pserv5's precomp.h when building the checks in this directory.
+///
+/// The sources under test include "precomp.h", which pulls in the Windows SDK,
+/// ImGui and the other dependencies of the application. The files built here
+/// only need the standard library and spdlog, so this header provides those,
+/// plus the few Windows definitions they use when the SDK is not available.
+#pragma once
+
+// Built like pservc: no ImGui
+#define PSERV_CONSOLE_BUILD
+
+// C++20 Standard Library
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <ranges>
+#include <span>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <stop_token>
+#include <condition_variable>
+#include <chrono>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <mutex>
+#include <variant>
+#include <optional>
+#include <charconv>
+#include <numeric>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <regex>
+
+// spdlog
+#include <spdlog/spdlog.h>
+
+// Standard libraries without <format> (libstdc++ before 13) get the fmt it is modeled on
+#if __has_include(<format>)
+#include <format>
+#endif
+#if !defined(__cpp_lib_format)
+#include <fmt/format.h>
+namespace std
+{
+    using fmt::format;
+    using fmt::format_string;
+} // namespace std
+#endif
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+// Just enough of the Windows API for the sources built here. String conversions only
+// handle ASCII, and LCMapStringEx fails, so collation keys fall back to case folding.
+using DWORD = uint32_t;
+using LONG = int32_t;
+using BOOL = int;
+using LPWSTR = wchar_t *;
+
+struct FILETIME
+{
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+};
+
+struct RECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+
+#define CP_UTF8 65001
+#define LOCALE_NAME_USER_DEFAULT nullptr
+#define LCMAP_SORTKEY 0x00000400
+#define LINGUISTIC_IGNORECASE 0x00000010
+
+inline uint64_t InterlockedIncrement(volatile uint64_t *pValue)
+{
+    *pValue = *pValue + 1;
+    return *pValue;
+}
+
+inline int MultiByteToWideChar(unsigned, DWORD, const char *pSource, int sourceLength, wchar_t *pDestination, int destinationLength)
+{
+    if (pDestination != nullptr)
+    {
+        for (int i = 0; i < sourceLength && i < destinationLength; ++i)
+            pDestination[i] = static_cast<unsigned char>(pSource[i]);
+    }
+    return sourceLength;
+}
+
+inline int WideCharToMultiByte(unsigned, DWORD, const wchar_t *pSource, int sourceLength, char *pDestination, int destinationLength, const char *, BOOL *)
+{
+    if (pDestination != nullptr)
+    {
+        for (int i = 0; i < sourceLength && i < destinationLength; ++i)
+            pDestination[i] = static_cast<char>(pSource[i]);
+    }
+    return sourceLength;
+}
+
+#define FORMAT_MESSAGE_ALLOCATE_BUFFER 0x00000100
+#define FORMAT_MESSAGE_IGNORE_INSERTS 0x00000200
+#define FORMAT_MESSAGE_FROM_SYSTEM 0x00001000
+#define LANG_NEUTRAL 0x00
+#define SUBLANG_DEFAULT 0x01
+#define MAKELANGID(p, s) ((static_cast<DWORD>(s) << 10) | static_cast<DWORD>(p))
+
+inline DWORD GetLastError()
+{
+    return 0;
+}
+
+inline DWORD FormatMessageW(DWORD, const void *, DWORD, DWORD, LPWSTR, DWORD, void *)
+{
+    return 0;
+}
+
+inline void *LocalFree(void *)
+{
+    return nullptr;
+}
+
+// Security identifiers: conversions fail, so SIDs have no account name
+using PSID = void *;
+using SID_NAME_USE = int;
+
+inline BOOL ConvertStringSidToSidW(const wchar_t *, PSID *)
+{
+    return 0;
+}
+
+inline BOOL LookupAccountSidW(const wchar_t *, PSID, wchar_t *, DWORD *, wchar_t *, DWORD *, SID_NAME_USE *)
+{
+    return 0;
+}
+
+inline int LCMapStringEx(const wchar_t *, DWORD, const wchar_t *, int, wchar_t *, int, void *, void *, intptr_t)
+{
+    return 0;
+}
+#endif
+
+#define DBG_NEW new
+
+/// This macro can be used on classes that should not enable a copy / move constructor / assignment operator
+#define DECLARE_NON_COPYABLE(__CLASSNAME__) \
+    __CLASSNAME__(const __CLASSNAME__ &) = delete; \
+    __CLASSNAME__ &operator=(const __CLASSNAME__ &) = delete; \
+    __CLASSNAME__(__CLASSNAME__ &&) = delete; \
+    __CLASSNAME__ &operator=(__CLASSNAME__ &&) = delete;
@@ -0,0 +1,267 @@
+/// @file process_details_cache_test.cpp
+/// @brief Tests ProcessDetailsCache with a fake ProcessDetailsProvider.
+#include "precomp.h"
+#include <windows_api/process_details_cache.h>
+#include "test_check.h"
+
+using namespace pserv;
+
+namespace
+{
+    /// Returns details naming the PID and the number of the query, and counts the queries.
+    class FakeProvider final : public ProcessDetailsProvider
+    {
+    public:
+        explicit FakeProvider(std::chrono::microseconds queryTime = {}, std::set<DWORD> failingPids = {})
+            : m_queryTime{queryTime},
+              m_failingPids{std::move(failingPids)}
+        {
+        }
+
+        ProcessDetails Query(DWORD pid) const override
+        {
+            const size_t query = ++m_queryCount;
+            if (m_failingPids.contains(pid))
+            {
+                throw std::runtime_error{std::format("process {} is gone", pid)};
+            }
+            if (m_queryTime.count() > 0)
+            {
+                std::this_thread::sleep_for(m_queryTime);
+            }
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_threadIds.insert(std::this_thread::get_id());
+            }
+            return ProcessDetails{
+                .User = std::format("user{}", pid),
+                .UserSid = {},
+                .Path = std::format("C:\\process{}.exe", pid),
+                .CommandLine = std::format("process{}.exe --query={}", pid, query),
+            };
+        }
+
+        size_t GetQueryCount() const noexcept
+        {
+            return m_queryCount;
+        }
+
+        size_t GetThreadCount() const
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            return m_threadIds.size();
+        }
+
+    private:
+        const std::chrono::microseconds m_queryTime;
+        const std::set<DWORD> m_failingPids;
+        mutable std::atomic<size_t> m_queryCount{0};
+        mutable std::mutex m_mutex;
+        mutable std::set<std::thread::id> m_threadIds;
+    };
+
+    FILETIME MakeCreationTime(uint64_t time)
+    {
+        return FILETIME{static_cast<DWORD>(time), static_cast<DWORD>(time >> 32)};
+    }
+
+    /// A cache with a fake provider that the test can still inspect.
+    struct TestCache final
+    {
+        explicit TestCache(std::chrono::microseconds queryTime = {}, std::set<DWORD> failingPids = {})
+        {
+            auto pProvider = std::make_unique<FakeProvider>(queryTime, std::move(failingPids));
+            Provider = pProvider.get();
+            Cache = std::make_unique<ProcessDetailsCache>(std::move(pProvider));
+        }
+
+        const FakeProvider *Provider;
+        std::unique_ptr<ProcessDetailsCache> Cache;
+    };
+
+    void TestHitForSameInstance()
+    {
+        TestCache test;
+        const auto creationTime = MakeCreationTime(0x01DB000012345678);
+
+        const auto pFirst = test.Cache->Get(100, creationTime, true);
+        if (!CHECK(pFirst != nullptr))
+            return;
+        CHECK(pFirst->Path == "C:\\process100.exe");
+        CHECK(test.Provider->GetQueryCount() == 1);
+
+        // Later refreshes of the same process instance are served from the cache
+        for (int refresh = 0; refresh < 3; ++refresh)
+        {
+            test.Cache->EvictUnseen();
+            const auto pAgain = test.Cache->Get(100, creationTime, true);
+            CHECK(pAgain != nullptr && pAgain->CommandLine == "process100.exe --query=1");
+        }
+        CHECK(test.Provider->GetQueryCount() == 1);
+        CHECK(test.Cache->GetSize() == 1);
+    }
+
+    void TestMissWithoutLoad()
+    {
+        TestCache test;
+        CHECK(test.Cache->Get(100, MakeCreationTime(1), false) == nullptr);
+        CHECK(test.Provider->GetQueryCount() == 0);
+        CHECK(test.Cache->GetSize() == 0);
+    }
+
+    void TestMissAfterPidReuse()
+    {
+        TestCache test;
+        CHECK(test.Cache->Get(100, MakeCreationTime(1000), true) != nullptr);
+        test.Cache->EvictUnseen();
+
+        // Same PID, new creation time: another process, whose details must be read again
+        const auto pReused = test.Cache->Get(100, MakeCreationTime(2000), true);
+        CHECK(pReused != nullptr && pReused->CommandLine == "process100.exe --query=2");
+        CHECK(test.Provider->GetQueryCount() == 2);
+
+        // Creation times that differ only in the high part are different instances, too
+        CHECK(test.Cache->Get(100, MakeCreationTime(2000 + (uint64_t{1} << 32)), true) != nullptr);
+        CHECK(test.Provider->GetQueryCount() == 3);
+
+        // The old instance was not seen in this enumeration, so it is dropped
+        test.Cache->EvictUnseen();
+        CHECK(test.Cache->GetSize() == 2);
+        CHECK(test.Cache->Get(100, MakeCreationTime(1000), false) == nullptr);
+    }
+
+    void TestEvictionOfExitedProcesses()
+    {
+        TestCache test;
+        for (DWORD pid = 1; pid <= 10; ++pid)
+        {
+            test.Cache->Get(pid, MakeCreationTime(pid), true);
+        }
+        test.Cache->EvictUnseen();
+        CHECK(test.Cache->GetSize() == 10);
+
+        // Odd PIDs exit: only the even ones are enumerated again
+        for (DWORD pid = 2; pid <= 10; pid += 2)
+        {
+            CHECK(test.Cache->Get(pid, MakeCreationTime(pid), false) != nullptr);
+        }
+        test.Cache->EvictUnseen();
+        CHECK(test.Cache->GetSize() == 5);
+        CHECK(test.Cache->Get(3, MakeCreationTime(3), false) == nullptr);
+        CHECK(test.Cache->Get(4, MakeCreationTime(4), false) != nullptr);
+        CHECK(test.Provider->GetQueryCount() == 10);
+
+        // An enumeration without any process empties the cache
+        test.Cache->EvictUnseen();
+        test.Cache->EvictUnseen();
+        CHECK(test.Cache->GetSize() == 0);
+    }
+
+    std::vector<ProcessDetailsCache::Instance> MakeInstances(DWORD firstPid, size_t count)
+    {
+        std::vector<ProcessDetailsCache::Instance> instances;
+        for (DWORD pid = firstPid; pid < firstPid + count; ++pid)
+        {
+            instances.push_back({pid, MakeCreationTime(pid * 10)});
+        }
+        return instances;
+    }
+
+    void TestParallelLoad()
+    {
+        const size_t previousParallelism = ProcessDetailsCache::GetParallelism();
+        ProcessDetailsCache::SetParallelism(4);
+
+        TestCache test{std::chrono::microseconds{200}};
+        const auto instances = MakeInstances(1, 300);
+        test.Cache->Load(instances);
+        CHECK(test.Provider->GetQueryCount() == instances.size());
+        CHECK(test.Cache->GetSize() == instances.size());
+        CHECK(test.Provider->GetThreadCount() > 1);
+
+        // Every instance got its own details, and they are found by Get() without another query
+        for (const auto &instance : instances)
+        {
+            const auto pDetails = test.Cache->Get(instance.Pid, instance.CreationTime, false);
+            CHECK(pDetails != nullptr && pDetails->Path == std::format("C:\\process{}.exe", instance.Pid));
+        }
+
+        // Loading again only queries the instances that are new; Load() marks the rest as seen
+        test.Cache->EvictUnseen();
+        const auto moreInstances = MakeInstances(201, 150);
+        test.Cache->Load(moreInstances);
+        CHECK(test.Provider->GetQueryCount() == instances.size() + 50);
+        test.Cache->EvictUnseen();
+        CHECK(test.Cache->GetSize() == moreInstances.size());
+
+        ProcessDetailsCache::SetParallelism(previousParallelism);
+    }
+
+    void TestSerialLoad()
+    {
+        const size_t previousParallelism = ProcessDetailsCache::GetParallelism();
+        for (const size_t parallelism : {size_t{0}, size_t{1}})
+        {
+            ProcessDetailsCache::SetParallelism(parallelism);
+            TestCache test;
+            test.Cache->Load(MakeInstances(1, 20));
+            CHECK(test.Cache->GetSize() == 20);
+            CHECK(test.Provider->GetThreadCount() == 1);
+        }
+
+        // More threads than instances
+        ProcessDetailsCache::SetParallelism(64);
+        TestCache test;
+        test.Cache->Load(MakeInstances(1, 3));
+        CHECK(test.Cache->GetSize() == 3);
+        test.Cache->Load({});
+        CHECK(test.Cache->GetSize() == 3);
+
+        ProcessDetailsCache::SetParallelism(previousParallelism);
+    }
+
+    void TestLoadWithFailingQueries()
+    {
+        const size_t previousParallelism = ProcessDetailsCache::GetParallelism();
+        for (const size_t parallelism : {size_t{1}, size_t{4}})
+        {
+            ProcessDetailsCache::SetParallelism(parallelism);
+
+            // Every 7th process fails, on the worker threads and on the calling thread alike
+            std::set<DWORD> failingPids;
+            for (DWORD pid = 7; pid <= 100; pid += 7)
+            {
+                failingPids.insert(pid);
+            }
+            TestCache test{std::chrono::microseconds{50}, failingPids};
+            test.Cache->Load(MakeInstances(1, 100));
+            CHECK(test.Provider->GetQueryCount() == 100);
+            CHECK(test.Cache->GetSize() == 100);
+
+            // The failed ones have empty details, the others are unaffected
+            for (DWORD pid = 1; pid <= 100; ++pid)
+            {
+                const auto pDetails = test.Cache->Get(pid, MakeCreationTime(pid * 10), false);
+                if (!CHECK(pDetails != nullptr))
+                    continue;
+                CHECK(pDetails->Path == (failingPids.contains(pid) ? std::string{} : std::format("C:\\process{}.exe", pid)));
+            }
+        }
+        ProcessDetailsCache::SetParallelism(previousParallelism);
+    }
+} // namespace
+
+int main()
+{
+    // The failing queries would be logged as errors
+    spdlog::set_level(spdlog::level::off);
+
+    TestHitForSameInstance();
+    TestMissWithoutLoad();
+    TestMissAfterPidReuse();
+    TestEvictionOfExitedProcesses();
+    TestParallelLoad();
+    TestSerialLoad();
+    TestLoadWithFailingQueries();
+    return tests::GetTestExitCode();
+}
@@ -0,0 +1,283 @@
+/// @file sid_name_cache_test.cpp
+/// @brief Tests SidNameCache with an in-memory SidResolver.
+#include "precomp.h"
+#include <windows_api/sid_name_cache.h>
+#include "test_check.h"
+
+using namespace pserv;
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr auto NAME_TTL = 300ms;
+    constexpr auto MISSING_NAME_TTL = 150ms;
+
+    const std::string ALICE_SID{"S-1-5-21-1-1001"};
+    const std::string BOB_SID{"S-1-5-21-1-1002"};
+    const std::string SYSTEM_SID{"S-1-5-18"};
+
+    /// An account directory in memory. Lookups can be held until Release() to observe pending names.
+    class InMemoryResolver final : public SidResolver
+    {
+    public:
+        explicit InMemoryResolver(std::atomic<bool> &bDestroyed)
+            : m_bDestroyed{bDestroyed}
+        {
+        }
+
+        ~InMemoryResolver() override
+        {
+            m_bDestroyed = true;
+        }
+
+        std::optional<std::string> LookupAccountName(const std::string &sid) const override
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            ++m_lookupCount;
+            m_released.wait(lock, [this]() { return !m_bHeld; });
+            const auto it = m_names.find(sid);
+            if (it == m_names.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        void SetName(const std::string &sid, std::optional<std::string> name)
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (name)
+                m_names[sid] = *name;
+            else
+                m_names.erase(sid);
+        }
+
+        void Hold()
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_bHeld = true;
+        }
+
+        void Release()
+        {
+            // Notify with the lock held: after a shutdown the released lookup may destroy us right after
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_bHeld = false;
+            m_released.notify_all();
+        }
+
+        int GetLookupCount() const
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            return m_lookupCount;
+        }
+
+    private:
+        std::atomic<bool> &m_bDestroyed;
+        mutable std::mutex m_mutex;
+        mutable std::condition_variable m_released;
+        std::map<std::string, std::string> m_names;
+        bool m_bHeld{false};
+        mutable int m_lookupCount{0};
+    };
+
+    /// Wait until @p condition holds, for a few seconds at most.
+    template <typename Condition> bool WaitUntil(Condition condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    /// A cache with an in-memory resolver that the test can still change.
+    struct TestCache final
+    {
+        TestCache()
+        {
+            auto pResolver = std::make_unique<InMemoryResolver>(bResolverDestroyed);
+            Resolver = pResolver.get();
+            Resolver->SetName(ALICE_SID, "CORP\\alice");
+            Resolver->SetName(SYSTEM_SID, "NT AUTHORITY\\SYSTEM");
+            Cache = std::make_unique<SidNameCache>(std::move(pResolver), NAME_TTL, MISSING_NAME_TTL);
+        }
+
+        ~TestCache()
+        {
+            // Let a held lookup finish. A worker detached in the middle of a lookup owns
+            // the resolver, which refers to us, so wait until it is gone.
+            if (Cache)
+                Resolver->Release();
+            Cache.reset();
+            WaitUntil([this]() { return bResolverDestroyed.load(); });
+        }
+
+        std::atomic<bool> bResolverDestroyed{false};
+        InMemoryResolver *Resolver;
+        std::unique_ptr<SidNameCache> Cache;
+    };
+
+    /// Wait until a background lookup finished after @p revision was read.
+    bool WaitForRevision(const SidNameCache &cache, uint64_t revision)
+    {
+        return WaitUntil([&cache, revision]() { return cache.GetRevision() != revision; });
+    }
+
+    void TestPendingThenResolved()
+    {
+        TestCache test;
+        test.Resolver->Hold();
+
+        // While the lookup is pending, the SID stands in for the name and nothing is queued twice
+        const uint64_t revision = test.Cache->GetRevision();
+        CHECK(test.Cache->GetName(ALICE_SID) == ALICE_SID);
+        for (int i = 0; i < 100; ++i)
+        {
+            CHECK(test.Cache->GetName(ALICE_SID) == ALICE_SID);
+        }
+        CHECK(test.Cache->GetRevision() == revision);
+
+        test.Resolver->Release();
+        CHECK(WaitForRevision(*test.Cache, revision));
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice");
+        CHECK(test.Resolver->GetLookupCount() == 1);
+    }
+
+    void TestNegativeCaching()
+    {
+        TestCache test;
+        const uint64_t revision = test.Cache->GetRevision();
+        CHECK(test.Cache->GetName(BOB_SID) == BOB_SID);
+        CHECK(WaitForRevision(*test.Cache, revision));
+
+        // A SID without a name is not looked up again until its TTL expires
+        for (int i = 0; i < 100; ++i)
+        {
+            CHECK(test.Cache->GetName(BOB_SID) == BOB_SID);
+        }
+        CHECK(test.Cache->GetNameNow(BOB_SID) == BOB_SID);
+        CHECK(test.Resolver->GetLookupCount() == 1);
+    }
+
+    void TestMissingNameTtlExpiry()
+    {
+        TestCache test;
+        uint64_t revision = test.Cache->GetRevision();
+        test.Cache->GetName(BOB_SID);
+        CHECK(WaitForRevision(*test.Cache, revision));
+
+        // The account appears (e.g. a domain became reachable), and shows up once the TTL expired
+        test.Resolver->SetName(BOB_SID, "CORP\\bob");
+        std::this_thread::sleep_for(MISSING_NAME_TTL + 20ms);
+        revision = test.Cache->GetRevision();
+        CHECK(test.Cache->GetName(BOB_SID) == BOB_SID);
+        CHECK(WaitForRevision(*test.Cache, revision));
+        CHECK(test.Cache->GetName(BOB_SID) == "CORP\\bob");
+        CHECK(test.Resolver->GetLookupCount() == 2);
+    }
+
+    void TestNameTtlExpiry()
+    {
+        TestCache test;
+        uint64_t revision = test.Cache->GetRevision();
+        test.Cache->GetName(ALICE_SID);
+        CHECK(WaitForRevision(*test.Cache, revision));
+
+        // Within the TTL, a renamed account keeps its old name
+        test.Resolver->SetName(ALICE_SID, "CORP\\alice.smith");
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice");
+        CHECK(test.Resolver->GetLookupCount() == 1);
+
+        // After it, the old name is returned until the new lookup finished
+        std::this_thread::sleep_for(NAME_TTL + 20ms);
+        test.Resolver->Hold();
+        revision = test.Cache->GetRevision();
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice");
+        test.Resolver->Release();
+        CHECK(WaitForRevision(*test.Cache, revision));
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice.smith");
+        CHECK(test.Resolver->GetLookupCount() == 2);
+    }
+
+    void TestKeepsNameWhenLookupFails()
+    {
+        TestCache test;
+        uint64_t revision = test.Cache->GetRevision();
+        test.Cache->GetName(ALICE_SID);
+        CHECK(WaitForRevision(*test.Cache, revision));
+
+        // The domain becomes unreachable: the re-lookup after the TTL fails, but the name stays
+        test.Resolver->SetName(ALICE_SID, std::nullopt);
+        std::this_thread::sleep_for(NAME_TTL + 20ms);
+        revision = test.Cache->GetRevision();
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice");
+        CHECK(WaitForRevision(*test.Cache, revision));
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice");
+        CHECK(test.Cache->GetNameNow(ALICE_SID) == "CORP\\alice");
+        CHECK(test.Resolver->GetLookupCount() == 2);
+
+        // It is retried as soon as a SID without a name, and a new name replaces the old one
+        test.Resolver->SetName(ALICE_SID, "CORP\\alice.smith");
+        std::this_thread::sleep_for(MISSING_NAME_TTL + 20ms);
+        revision = test.Cache->GetRevision();
+        test.Cache->GetName(ALICE_SID);
+        CHECK(WaitForRevision(*test.Cache, revision));
+        CHECK(test.Cache->GetName(ALICE_SID) == "CORP\\alice.smith");
+        CHECK(test.Resolver->GetLookupCount() == 3);
+    }
+
+    void TestGetNameNow()
+    {
+        TestCache test;
+        CHECK(test.Cache->GetNameNow(SYSTEM_SID) == "NT AUTHORITY\\SYSTEM");
+        CHECK(test.Cache->GetNameNow(SYSTEM_SID) == "NT AUTHORITY\\SYSTEM");
+
+        // The name is cached for GetName(), too
+        CHECK(test.Cache->GetName(SYSTEM_SID) == "NT AUTHORITY\\SYSTEM");
+        CHECK(test.Resolver->GetLookupCount() == 1);
+    }
+
+    void TestDestructionWithQueuedLookups()
+    {
+        // The lookups still queued are dropped
+        TestCache test;
+        for (int i = 0; i < 20; ++i)
+        {
+            test.Cache->GetName(std::format("S-1-5-21-7-{}", i));
+        }
+        test.Cache.reset();
+    }
+
+    void TestShutdownDoesNotWaitForLookup()
+    {
+        TestCache test;
+        test.Resolver->Hold();
+        test.Cache->GetName(ALICE_SID);
+        CHECK(WaitUntil([&test]() { return test.Resolver->GetLookupCount() == 1; }));
+
+        // The lookup is blocked (like LookupAccountSidW for an unreachable domain), and would block destruction forever
+        test.Cache->Shutdown();
+        CHECK(test.Cache->GetName(BOB_SID) == BOB_SID);
+        test.Cache.reset();
+        CHECK(!test.bResolverDestroyed);
+
+        // The worker finishes the lookup on its own, and then releases the resolver
+        test.Resolver->Release();
+        CHECK(WaitUntil([&test]() { return test.bResolverDestroyed.load(); }));
+    }
+} // namespace
+
+int main()
+{
+    TestPendingThenResolved();
+    TestNegativeCaching();
+    TestMissingNameTtlExpiry();
+    TestNameTtlExpiry();
+    TestKeepsNameWhenLookupFails();
+    TestGetNameNow();
+    TestDestructionWithQueuedLookups();
+    TestShutdownDoesNotWaitForLookup();
+    return tests::GetTestExitCode();
+}
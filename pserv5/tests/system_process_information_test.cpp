@@ -0,0 +1,319 @@
+/// @file system_process_information_test.cpp
+/// @brief Tests ParseSystemProcessInformation() on synthetic x64 and x86 buffers.
+///
+/// The buffers are written field by field at the documented offsets of
+/// SYSTEM_PROCESS_INFORMATION, independently of the structure the parser uses.
+#include "precomp.h"
+#include <windows_api/system_process_information.h>
+#include "test_check.h"
+
+using namespace pserv;
+
+namespace
+{
+    /// Offsets of the fields in one entry, and the sizes that depend on the pointer size.
+    struct EntryLayout final
+    {
+        SystemProcessInformationLayout Layout;
+        size_t PointerSize;
+        size_t EntrySize;
+        size_t ThreadInformationSize; ///< Size of one SYSTEM_THREAD_INFORMATION after the entry.
+        size_t ImageNameBuffer;
+        size_t BasePriority;
+        size_t UniqueProcessId;
+        size_t InheritedFromUniqueProcessId;
+        size_t HandleCount;
+        size_t SessionId;
+        size_t VirtualSize;
+        size_t PageFaultCount;
+        size_t PeakWorkingSetSize;
+        size_t WorkingSetSize;
+        size_t QuotaPagedPoolUsage;
+        size_t QuotaNonPagedPoolUsage;
+        size_t PagefileUsage;
+    };
+
+    constexpr EntryLayout X64_LAYOUT{SystemProcessInformationLayout::X64, 8, 0x100, 0x50, 0x40, 0x48, 0x50, 0x58, 0x60, 0x64, 0x78, 0x80, 0x88, 0x90, 0xA0, 0xB0, 0xB8};
+    constexpr EntryLayout X86_LAYOUT{SystemProcessInformationLayout::X86, 4, 0xB8, 0x40, 0x3C, 0x40, 0x44, 0x48, 0x4C, 0x50, 0x5C, 0x60, 0x64, 0x68, 0x70, 0x78, 0x7C};
+
+    // Fields at the same offset in both layouts
+    constexpr size_t NEXT_ENTRY_OFFSET = 0x00;
+    constexpr size_t NUMBER_OF_THREADS = 0x04;
+    constexpr size_t CREATE_TIME = 0x20;
+    constexpr size_t USER_TIME = 0x28;
+    constexpr size_t KERNEL_TIME = 0x30;
+    constexpr size_t IMAGE_NAME_LENGTH = 0x38;
+    constexpr size_t IMAGE_NAME_MAXIMUM_LENGTH = 0x3A;
+
+    struct TestProcess final
+    {
+        uint32_t ProcessId;
+        uint32_t ParentProcessId;
+        uint32_t ThreadCount;
+        std::u16string ImageName;
+        int32_t BasePriority;
+        uint64_t WorkingSetSize;
+    };
+
+    const std::vector<TestProcess> PROCESSES{
+        {0, 0, 8, u"", 0, 8192},
+        {4, 0, 200, u"System", 8, 1 << 20},
+        {1234, 4, 3, u"notepad.exe", 13, 5 << 20},
+    };
+
+    template <typename T> void Write(std::vector<std::byte> &buffer, size_t offset, T value)
+    {
+        std::memcpy(buffer.data() + offset, &value, sizeof(value));
+    }
+
+    void WritePointer(std::vector<std::byte> &buffer, const EntryLayout &layout, size_t offset, uint64_t value)
+    {
+        if (layout.PointerSize == 8)
+            Write<uint64_t>(buffer, offset, value);
+        else
+            Write<uint32_t>(buffer, offset, static_cast<uint32_t>(value));
+    }
+
+    /// Offset of the entry after the one at @p offset: past its thread array and image name, aligned to 8.
+    size_t GetNextEntryOffset(const EntryLayout &layout, const TestProcess &process, size_t padding)
+    {
+        const size_t size = layout.EntrySize + process.ThreadCount * layout.ThreadInformationSize + (process.ImageName.size() + 1) * sizeof(char16_t);
+        return ((size + 7) & ~size_t{7}) + padding;
+    }
+
+    /// Build the buffer NtQuerySystemInformation would write at @p bufferAddress.
+    /// @param padding Extra bytes between two entries, which the parser must skip via NextEntryOffset.
+    std::vector<std::byte> BuildBuffer(const EntryLayout &layout, const std::vector<TestProcess> &processes, uint64_t bufferAddress, size_t padding = 0)
+    {
+        size_t size = 0;
+        for (const auto &process : processes)
+        {
+            size += GetNextEntryOffset(layout, process, padding);
+        }
+
+        std::vector<std::byte> buffer(size);
+        size_t offset = 0;
+        for (size_t i = 0; i < processes.size(); ++i)
+        {
+            const auto &process = processes[i];
+            const size_t nextEntryOffset = GetNextEntryOffset(layout, process, padding);
+            const size_t nameOffset = offset + layout.EntrySize + process.ThreadCount * layout.ThreadInformationSize;
+            const auto nameLength = static_cast<uint16_t>(process.ImageName.size() * sizeof(char16_t));
+
+            Write<uint32_t>(buffer, offset + NEXT_ENTRY_OFFSET, (i + 1 < processes.size()) ? static_cast<uint32_t>(nextEntryOffset) : 0);
+            Write<uint32_t>(buffer, offset + NUMBER_OF_THREADS, process.ThreadCount);
+            Write<int64_t>(buffer, offset + CREATE_TIME, 1000 + process.ProcessId);
+            Write<int64_t>(buffer, offset + USER_TIME, 111);
+            Write<int64_t>(buffer, offset + KERNEL_TIME, 222);
+            Write<uint16_t>(buffer, offset + IMAGE_NAME_LENGTH, nameLength);
+            Write<uint16_t>(buffer, offset + IMAGE_NAME_MAXIMUM_LENGTH, static_cast<uint16_t>(nameLength + sizeof(char16_t)));
+            WritePointer(buffer, layout, offset + layout.ImageNameBuffer, process.ImageName.empty() ? 0 : bufferAddress + nameOffset);
+            std::memcpy(buffer.data() + nameOffset, process.ImageName.data(), nameLength);
+            Write<int32_t>(buffer, offset + layout.BasePriority, process.BasePriority);
+            WritePointer(buffer, layout, offset + layout.UniqueProcessId, process.ProcessId);
+            WritePointer(buffer, layout, offset + layout.InheritedFromUniqueProcessId, process.ParentProcessId);
+            Write<uint32_t>(buffer, offset + layout.HandleCount, process.ThreadCount * 10);
+            Write<uint32_t>(buffer, offset + layout.SessionId, 1);
+            WritePointer(buffer, layout, offset + layout.VirtualSize, 5000);
+            Write<uint32_t>(buffer, offset + layout.PageFaultCount, 77);
+            WritePointer(buffer, layout, offset + layout.PeakWorkingSetSize, process.WorkingSetSize * 2);
+            WritePointer(buffer, layout, offset + layout.WorkingSetSize, process.WorkingSetSize);
+            WritePointer(buffer, layout, offset + layout.QuotaPagedPoolUsage, 10);
+            WritePointer(buffer, layout, offset + layout.QuotaNonPagedPoolUsage, 20);
+            WritePointer(buffer, layout, offset + layout.PagefileUsage, 4096);
+            offset += nextEntryOffset;
+        }
+        return buffer;
+    }
+
+    /// An address the buffer had at capture time, which fits the pointer size of the layout.
+    uint64_t GetCaptureAddress(const EntryLayout &layout)
+    {
+        return (layout.PointerSize == 8) ? 0x7FF612340000 : 0x01230000;
+    }
+
+    bool Parse(std::span<const std::byte> buffer, const EntryLayout &layout, std::vector<SystemProcessRecord> &records)
+    {
+        return ParseSystemProcessInformation(buffer, GetCaptureAddress(layout), layout.Layout, records);
+    }
+
+    void CheckRecords(const std::vector<SystemProcessRecord> &records, const std::vector<TestProcess> &processes)
+    {
+        if (!CHECK(records.size() == processes.size()))
+            return;
+
+        for (size_t i = 0; i < processes.size(); ++i)
+        {
+            const auto &record = records[i];
+            const auto &process = processes[i];
+            CHECK(record.ProcessId == process.ProcessId);
+            CHECK(record.ParentProcessId == process.ParentProcessId);
+            CHECK(record.ThreadCount == process.ThreadCount);
+            CHECK(record.HandleCount == process.ThreadCount * 10);
+            CHECK(record.SessionId == 1);
+            CHECK(record.PageFaultCount == 77);
+            CHECK(record.BasePriority == process.BasePriority);
+            CHECK(record.CreateTime == 1000 + process.ProcessId);
+            CHECK(record.UserTime == 111);
+            CHECK(record.KernelTime == 222);
+            CHECK(record.VirtualSize == 5000);
+            CHECK(record.WorkingSetSize == process.WorkingSetSize);
+            CHECK(record.PeakWorkingSetSize == process.WorkingSetSize * 2);
+            CHECK(record.PrivateBytes == 4096);
+            CHECK(record.PagedPoolUsage == 10);
+            CHECK(record.NonPagedPoolUsage == 20);
+            CHECK(record.ImageName == process.ImageName);
+        }
+    }
+
+    void TestLayout(const EntryLayout &layout)
+    {
+        const auto buffer = BuildBuffer(layout, PROCESSES, GetCaptureAddress(layout));
+        std::vector<SystemProcessRecord> records;
+        CHECK(Parse(buffer, layout, records));
+        CheckRecords(records, PROCESSES);
+
+        // Parsed with the other pointer size, the entries do not line up
+        const auto &otherLayout = (layout.PointerSize == 8) ? X86_LAYOUT : X64_LAYOUT;
+        ParseSystemProcessInformation(buffer, GetCaptureAddress(layout), otherLayout.Layout, records);
+        CHECK(records.empty() || records.back().ProcessId != PROCESSES.back().ProcessId || records.back().ImageName != PROCESSES.back().ImageName);
+    }
+
+    void TestNextEntryOffsetChain(const EntryLayout &layout)
+    {
+        // Gaps between the entries are skipped, not parsed
+        const auto buffer = BuildBuffer(layout, PROCESSES, GetCaptureAddress(layout), 136);
+        std::vector<SystemProcessRecord> records;
+        CHECK(Parse(buffer, layout, records));
+        CheckRecords(records, PROCESSES);
+
+        // A next offset shorter than an entry, or past the end of the buffer
+        for (const uint32_t nextEntryOffset : {uint32_t{0x10}, static_cast<uint32_t>(layout.EntrySize - 1), static_cast<uint32_t>(buffer.size() + 1), uint32_t{0x7FFFFFFF}})
+        {
+            auto broken = buffer;
+            Write<uint32_t>(broken, NEXT_ENTRY_OFFSET, nextEntryOffset);
+            CHECK(!Parse(broken, layout, records));
+            CHECK(records.size() == 1);
+        }
+    }
+
+    void TestTruncatedBuffer(const EntryLayout &layout)
+    {
+        const auto buffer = BuildBuffer(layout, PROCESSES, GetCaptureAddress(layout));
+        const std::span<const std::byte> span{buffer};
+        std::vector<SystemProcessRecord> records;
+
+        // Cut inside the last entry: the records before it are kept
+        const size_t lastEntryOffset = buffer.size() - GetNextEntryOffset(layout, PROCESSES.back(), 0);
+        CHECK(!Parse(span.first(lastEntryOffset + layout.EntrySize - 1), layout, records));
+        CHECK(records.size() == PROCESSES.size() - 1);
+
+        CHECK(!Parse(span.first(layout.EntrySize - 1), layout, records));
+        CHECK(records.empty());
+        CHECK(!Parse({}, layout, records));
+        CHECK(records.empty());
+    }
+
+    void TestOverlongBuffer(const EntryLayout &layout)
+    {
+        // NtQuerySystemInformation gets a buffer with room to spare; the bytes after the last entry are ignored
+        auto buffer = BuildBuffer(layout, PROCESSES, GetCaptureAddress(layout));
+        buffer.resize(buffer.size() + 4096, std::byte{0xCC});
+        std::vector<SystemProcessRecord> records;
+        CHECK(Parse(buffer, layout, records));
+        CheckRecords(records, PROCESSES);
+    }
+
+    void TestImageNameOutsideBuffer(const EntryLayout &layout)
+    {
+        const uint64_t address = GetCaptureAddress(layout);
+        const auto buffer = BuildBuffer(layout, PROCESSES, address);
+        const size_t secondEntryOffset = GetNextEntryOffset(layout, PROCESSES[0], 0);
+        std::vector<SystemProcessRecord> records;
+
+        const auto checkNameRejected = [&](const std::vector<std::byte> &broken) {
+            // The name is dropped, the rest of the entry and the following entries are still parsed
+            CHECK(Parse(broken, layout, records));
+            if (CHECK(records.size() == PROCESSES.size()))
+            {
+                CHECK(records[1].ImageName.empty());
+                CHECK(records[1].ProcessId == PROCESSES[1].ProcessId);
+                CHECK(records[2].ImageName == PROCESSES[2].ImageName);
+            }
+        };
+
+        // Runs past the end of the buffer
+        auto broken = buffer;
+        Write<uint16_t>(broken, secondEntryOffset + IMAGE_NAME_LENGTH, 0xFFF0);
+        checkNameRejected(broken);
+
+        // Starts past the end of the buffer
+        broken = buffer;
+        WritePointer(broken, layout, secondEntryOffset + layout.ImageNameBuffer, address + buffer.size() + 2);
+        checkNameRejected(broken);
+
+        // Starts before the buffer
+        broken = buffer;
+        WritePointer(broken, layout, secondEntryOffset + layout.ImageNameBuffer, address - 2);
+        checkNameRejected(broken);
+
+        // Odd length or unaligned start
+        broken = buffer;
+        Write<uint16_t>(broken, secondEntryOffset + IMAGE_NAME_LENGTH, 5);
+        checkNameRejected(broken);
+
+        // Parsed with another buffer address, no name points into the buffer
+        CHECK(ParseSystemProcessInformation(buffer, address + 0x10000000, layout.Layout, records));
+        if (CHECK(records.size() == PROCESSES.size()))
+        {
+            CHECK(records[2].ImageName.empty());
+            CHECK(records[2].WorkingSetSize == PROCESSES[2].WorkingSetSize);
+        }
+    }
+
+    void TestUnalignedBuffer(const EntryLayout &layout)
+    {
+        // The entries are copied out, so the buffer needs no particular alignment
+        const auto buffer = BuildBuffer(layout, PROCESSES, GetCaptureAddress(layout) + 1);
+        std::vector<std::byte> storage(buffer.size() + 1);
+        std::memcpy(storage.data() + 1, buffer.data(), buffer.size());
+        std::vector<SystemProcessRecord> records;
+        CHECK(ParseSystemProcessInformation(std::span<const std::byte>{storage}.subspan(1), GetCaptureAddress(layout) + 1, layout.Layout, records));
+        if (CHECK(records.size() == PROCESSES.size()))
+        {
+            CHECK(records[2].ProcessId == PROCESSES[2].ProcessId);
+            CHECK(records[2].WorkingSetSize == PROCESSES[2].WorkingSetSize);
+        }
+    }
+
+    void TestNativeBufferInPlace()
+    {
+        // What NtQuerySystemInformation returns: the names point into the buffer itself
+        const auto &layout = (NATIVE_SYSTEM_PROCESS_INFORMATION_LAYOUT == SystemProcessInformationLayout::X64) ? X64_LAYOUT : X86_LAYOUT;
+        std::vector<std::byte> buffer(BuildBuffer(layout, PROCESSES, 0).size());
+        const auto content = BuildBuffer(layout, PROCESSES, reinterpret_cast<uintptr_t>(buffer.data()));
+        std::memcpy(buffer.data(), content.data(), content.size());
+
+        std::vector<SystemProcessRecord> records;
+        CHECK(ParseSystemProcessInformation(buffer, records));
+        CheckRecords(records, PROCESSES);
+    }
+} // namespace
+
+int main()
+{
+    // The malformed buffers would be logged as errors
+    spdlog::set_level(spdlog::level::off);
+
+    for (const auto *pLayout : {&X64_LAYOUT, &X86_LAYOUT})
+    {
+        TestLayout(*pLayout);
+        TestNextEntryOffsetChain(*pLayout);
+        TestTruncatedBuffer(*pLayout);
+        TestOverlongBuffer(*pLayout);
+        TestImageNameOutsideBuffer(*pLayout);
+        TestUnalignedBuffer(*pLayout);
+    }
+    TestNativeBufferInPlace();
+    return tests::GetTestExitCode();
+}
@@ -0,0 +1,44 @@
+/// @file test_check.h
+/// @brief Minimal checks for the tests in this directory.
+///
+/// Each test is a plain executable that ctest runs: CHECK() reports a failed
+/// condition with its location and continues, and main() returns
+/// GetTestExitCode() so ctest sees whether any check failed. Unlike assert()
+/// the checks also run in release builds.
+#pragma once
+
+#include <cstdio>
+
+namespace pserv::tests
+{
+    inline int &GetFailureCount()
+    {
+        static int failureCount = 0;
+        return failureCount;
+    }
+
+    inline bool Check(bool bCondition, const char *expression, const char *file, int line)
+    {
+        if (!bCondition)
+        {
+            std::printf("%s(%d): CHECK(%s) failed\n", file, line, expression);
+            ++GetFailureCount();
+        }
+        return bCondition;
+    }
+
+    /// @brief Print the summary and get the exit code for main().
+    inline int GetTestExitCode()
+    {
+        if (GetFailureCount() != 0)
+        {
+            std::printf("%d check(s) failed\n", GetFailureCount());
+            return 1;
+        }
+        std::printf("All checks passed\n");
+        return 0;
+    }
+} // namespace pserv::tests
+
+/// Report @p condition if it is false; evaluates to the condition.
+#define CHECK(condition) ::pserv::tests::Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
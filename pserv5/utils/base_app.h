@@ -11,6 +11,10 @@
 #include <utils/logging.h>
 #include <spdlog/spdlog.h>
 #include <config/settings.h>
+#include <core/data_object_container.h>
+#include <core/object_pool.h>
+#include <windows_api/process_details_cache.h>
+#include <windows_api/sid_name_cache.h>
 
 namespace pserv
 {
@@ -24,6 +28,7 @@ namespace pserv
         /// 3. Configuration from TOML file
         /// 4. File logging with configured path
         /// 5. Log level from configuration
+        /// 6. Performance settings (e.g. parallel sort threshold)
         class BaseApp final
         {
         public:
@@ -69,10 +74,21 @@ namespace pserv
                 std::string logLevel = config::theSettings.logging.logLevel.get();
                 logger->set_level(spdlog::level::from_str(logLevel));
                 logger->info("Log level set to: {}", logLevel);
+
+                // Step 6: Apply performance tuning
+                const int32_t parallelSortThreshold = config::theSettings.performance.parallelSortThreshold.get();
+                DataObjectContainer::SetParallelSortThreshold(static_cast<size_t>(std::max(parallelSortThreshold, 0)));
+                logger->info("Parallel sort threshold: {} rows", parallelSortThreshold);
+                const int32_t processDetailThreads = config::theSettings.performance.processDetailThreads.get();
+                ProcessDetailsCache::SetParallelism(static_cast<size_t>(std::max(processDetailThreads, 1)));
+                logger->info("Process detail threads: {}", processDetailThreads);
             }
 
             ~BaseApp()
             {
+                // Not left to the static's destructor: spdlog may be gone by then
+                SidNameCache::GetInstance().Shutdown();
+                ObjectPool::LogStatistics();
                 delete m_pBackend;
             }
 
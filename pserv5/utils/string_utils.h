@@ -2,8 +2,11 @@
 /// @brief String conversion and manipulation utilities.
 ///
 /// Provides UTF-8/UTF-16 conversion, case conversion, and clipboard operations.
+/// Case-insensitive searching (ContainsIgnoreCase) lives in text_search.h.
 #pragma once
 
+#include <utils/text_search.h>
+
 namespace pserv::utils
 {
     /// @brief Convert UTF-8 string to UTF-16 wide string.
@@ -41,14 +44,6 @@ namespace pserv::utils
         return result;
     }
 
-    /// @brief Check if a string contains a substring (case-insensitive).
-    /// @param key The string to search in.
-    /// @param lowerFilter The substring to find (must be pre-lowercased).
-    inline bool ContainsIgnoreCase(const std::string& key, const std::string& lowerFilter)
-    {
-        return utils::ToLower(key).find(lowerFilter) != std::string::npos;
-    }
-
     /// @brief Copy text to the system clipboard.
     /// Uses Win32 API in console build, ImGui in GUI build.
     #ifdef PSERV_CONSOLE_BUILD
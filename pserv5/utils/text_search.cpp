@@ -0,0 +1,300 @@
+#include "precomp.h"
+#include <utils/text_search.h>
+
+#include <bit>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PSERV_TEXT_SEARCH_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts AVX2 intrinsics in any function; GCC and Clang need them enabled per function
+#if defined(PSERV_TEXT_SEARCH_X86) && !defined(_MSC_VER)
+#define PSERV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PSERV_TARGET_AVX2
+#endif
+
+namespace pserv::utils
+{
+    using SearchKernel = size_t (*)(const char *haystack, size_t haystackSize, const char *needle, size_t needleSize);
+
+    static inline char FoldAscii(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+    }
+
+    static inline bool EqualsIgnoreAsciiCase(const char *a, const char *b, size_t size) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (FoldAscii(a[i]) != FoldAscii(b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    /// Candidate positions have a matching first and last byte; this checks the bytes in between.
+    static inline bool MatchesMiddle(const char *candidate, const char *needle, size_t needleSize) noexcept
+    {
+        return needleSize <= 2 || EqualsIgnoreAsciiCase(candidate + 1, needle + 1, needleSize - 2);
+    }
+
+    /// Scalar search for an ASCII needle, starting at haystack offset @p start.
+    static size_t FindAsciiScalarFrom(const char *haystack, size_t haystackSize, const char *needle, size_t needleSize, size_t start) noexcept
+    {
+        const char first = FoldAscii(needle[0]);
+        const char last = FoldAscii(needle[needleSize - 1]);
+        for (size_t i = start; i + needleSize <= haystackSize; ++i)
+        {
+            if (FoldAscii(haystack[i]) == first && FoldAscii(haystack[i + needleSize - 1]) == last &&
+                MatchesMiddle(haystack + i, needle, needleSize))
+            {
+                return i;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+#ifndef PSERV_TEXT_SEARCH_X86
+    static size_t FindAsciiScalar(const char *haystack, size_t haystackSize, const char *needle, size_t needleSize) noexcept
+    {
+        return FindAsciiScalarFrom(haystack, haystackSize, needle, needleSize, 0);
+    }
+#else
+    static inline char UpperAscii(char c) noexcept
+    {
+        return (c >= 'a' && c <= 'z') ? static_cast<char>(c & ~0x20) : c;
+    }
+
+    /// Lanes of @p block equal to either case of a needle byte. Cheaper than
+    /// folding the haystack, and bytes >= 0x80 never match an ASCII needle.
+    static inline __m128i CompareEitherCase128(__m128i block, __m128i lower, __m128i upper) noexcept
+    {
+        return _mm_or_si128(_mm_cmpeq_epi8(block, lower), _mm_cmpeq_epi8(block, upper));
+    }
+
+    static size_t FindAsciiSse2(const char *haystack, size_t haystackSize, const char *needle, size_t needleSize) noexcept
+    {
+        const char first = needle[0];
+        const char last = needle[needleSize - 1];
+        const __m128i firstLower = _mm_set1_epi8(FoldAscii(first));
+        const __m128i firstUpper = _mm_set1_epi8(UpperAscii(first));
+        const __m128i lastLower = _mm_set1_epi8(FoldAscii(last));
+        const __m128i lastUpper = _mm_set1_epi8(UpperAscii(last));
+
+        // Compare 16 candidate positions at once: one load for their first bytes, one for their last bytes
+        size_t i = 0;
+        for (; i + needleSize - 1 + 16 <= haystackSize; i += 16)
+        {
+            const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i));
+            const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + needleSize - 1));
+            const __m128i candidates = _mm_and_si128(CompareEitherCase128(blockFirst, firstLower, firstUpper), CompareEitherCase128(blockLast, lastLower, lastUpper));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(candidates));
+            while (mask != 0)
+            {
+                const size_t candidate = i + std::countr_zero(mask);
+                if (MatchesMiddle(haystack + candidate, needle, needleSize))
+                    return candidate;
+                mask &= mask - 1;
+            }
+        }
+        return FindAsciiScalarFrom(haystack, haystackSize, needle, needleSize, i);
+    }
+
+    PSERV_TARGET_AVX2 static inline __m256i CompareEitherCase256(__m256i block, __m256i lower, __m256i upper) noexcept
+    {
+        return _mm256_or_si256(_mm256_cmpeq_epi8(block, lower), _mm256_cmpeq_epi8(block, upper));
+    }
+
+    PSERV_TARGET_AVX2 static size_t FindAsciiAvx2(const char *haystack, size_t haystackSize, const char *needle, size_t needleSize) noexcept
+    {
+        const char first = needle[0];
+        const char last = needle[needleSize - 1];
+        const __m256i firstLower = _mm256_set1_epi8(FoldAscii(first));
+        const __m256i firstUpper = _mm256_set1_epi8(UpperAscii(first));
+        const __m256i lastLower = _mm256_set1_epi8(FoldAscii(last));
+        const __m256i lastUpper = _mm256_set1_epi8(UpperAscii(last));
+
+        size_t i = 0;
+        for (; i + needleSize - 1 + 32 <= haystackSize; i += 32)
+        {
+            const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i));
+            const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + needleSize - 1));
+            const __m256i candidates = _mm256_and_si256(CompareEitherCase256(blockFirst, firstLower, firstUpper), CompareEitherCase256(blockLast, lastLower, lastUpper));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(candidates));
+            while (mask != 0)
+            {
+                const size_t candidate = i + std::countr_zero(mask);
+                if (MatchesMiddle(haystack + candidate, needle, needleSize))
+                    return candidate;
+                mask &= mask - 1;
+            }
+        }
+        // Finish the last (up to 31) positions in scalar code; calling the non-VEX
+        // SSE2 kernel from here would pay an AVX-SSE transition on every search
+        return FindAsciiScalarFrom(haystack, haystackSize, needle, needleSize, i);
+    }
+
+    static bool IsAvx2Supported() noexcept
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // AVX2 needs the CPU feature and the OS saving the YMM registers
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif // PSERV_TEXT_SEARCH_X86
+
+    struct SelectedKernel
+    {
+        SearchKernel pFind;
+        const char *name;
+    };
+
+    static const SelectedKernel &GetSelectedKernel() noexcept
+    {
+        static const SelectedKernel kernel = []() -> SelectedKernel
+        {
+#ifdef PSERV_TEXT_SEARCH_X86
+            if (IsAvx2Supported())
+                return {&FindAsciiAvx2, "avx2"};
+            return {&FindAsciiSse2, "sse2"};
+#else
+            return {&FindAsciiScalar, "scalar"};
+#endif
+        }();
+        return kernel;
+    }
+
+    /// Decode one UTF-8 sequence and advance @p pos. Malformed bytes decode to a
+    /// value above U+10FFFF, so they only ever match the same malformed byte.
+    static char32_t DecodeUtf8(std::string_view text, size_t &pos) noexcept
+    {
+        const auto lead = static_cast<unsigned char>(text[pos]);
+        size_t length;
+        char32_t codePoint;
+        if (lead < 0x80)
+        {
+            ++pos;
+            return lead;
+        }
+        else if ((lead & 0xE0) == 0xC0)
+        {
+            length = 2;
+            codePoint = lead & 0x1F;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            length = 3;
+            codePoint = lead & 0x0F;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            length = 4;
+            codePoint = lead & 0x07;
+        }
+        else
+        {
+            ++pos;
+            return 0x110000 + lead;
+        }
+
+        if (pos + length > text.size())
+        {
+            ++pos;
+            return 0x110000 + lead;
+        }
+        for (size_t i = 1; i < length; ++i)
+        {
+            const auto trail = static_cast<unsigned char>(text[pos + i]);
+            if ((trail & 0xC0) != 0x80)
+            {
+                ++pos;
+                return 0x110000 + lead;
+            }
+            codePoint = (codePoint << 6) | (trail & 0x3F);
+        }
+        pos += length;
+        return codePoint;
+    }
+
+    /// Simple case folding for ASCII, Latin-1, Latin Extended-A, Greek and Cyrillic capitals.
+    static char32_t FoldCodePoint(char32_t c) noexcept
+    {
+        if (c < 0x80)
+            return (c >= 'A' && c <= 'Z') ? c + 0x20 : c;
+        if (c >= 0xC0 && c <= 0xDE && c != 0xD7)
+            return c + 0x20;
+        if ((c >= 0x100 && c <= 0x12F) || (c >= 0x132 && c <= 0x137) || (c >= 0x14A && c <= 0x177))
+            return c | 1;
+        if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E))
+            return (c & 1) ? c + 1 : c;
+        if (c == 0x178)
+            return 0xFF;
+        if (c >= 0x391 && c <= 0x3A9 && c != 0x3A2)
+            return c + 0x20;
+        if (c >= 0x400 && c <= 0x40F)
+            return c + 0x50;
+        if (c >= 0x410 && c <= 0x42F)
+            return c + 0x20;
+        return c;
+    }
+
+    /// Search for a needle with non-ASCII characters, comparing folded code points.
+    /// Matches start on code point boundaries only.
+    static size_t FindUtf8(std::string_view haystack, std::string_view needle) noexcept
+    {
+        size_t start = 0;
+        while (start < haystack.size())
+        {
+            size_t h = start;
+            size_t n = 0;
+            bool matches = true;
+            while (matches && n < needle.size())
+            {
+                matches = h < haystack.size() && FoldCodePoint(DecodeUtf8(haystack, h)) == FoldCodePoint(DecodeUtf8(needle, n));
+            }
+            if (matches)
+                return start;
+
+            DecodeUtf8(haystack, start);
+        }
+        return std::string_view::npos;
+    }
+
+    size_t FindIgnoreCase(std::string_view haystack, std::string_view needle) noexcept
+    {
+        if (needle.empty())
+            return 0;
+
+        const bool asciiNeedle = std::none_of(needle.begin(), needle.end(), [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+        if (!asciiNeedle)
+            return FindUtf8(haystack, needle);
+
+        if (needle.size() > haystack.size())
+            return std::string_view::npos;
+        return GetSelectedKernel().pFind(haystack.data(), haystack.size(), needle.data(), needle.size());
+    }
+
+    const char *GetTextSearchKernelName() noexcept
+    {
+        return GetSelectedKernel().name;
+    }
+} // namespace pserv::utils
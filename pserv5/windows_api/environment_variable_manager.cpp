@@ -64,8 +64,8 @@ namespace pserv
             std::string name = utils::WideToUtf8(valueName);
             std::string value = utils::WideToUtf8(reinterpret_cast<wchar_t *>(valueData));
 
-            const auto stableId{EnvironmentVariableInfo::GetStableID(scope, name)};
-            auto info = doc->GetByStableId<EnvironmentVariableInfo>(stableId);
+            const auto stableKey{EnvironmentVariableInfo::GetStableKey(scope, name)};
+            auto info = doc->GetByStableKey<EnvironmentVariableInfo>(stableKey);
             if (info == nullptr)
             {
                 info = doc->Append<EnvironmentVariableInfo>(DBG_NEW EnvironmentVariableInfo{name, value, scope});
@@ -92,8 +92,8 @@ namespace pserv
                 if (::GetModuleInformation(hProcess.get(), hModule, &moduleInfo, sizeof(moduleInfo)))
                 {
                     const CachedModuleInfo &cached = cacheIt->second;
-                    const auto stableId{ModuleInfo::GetStableID(processId, cached.name)};
-                    auto mi = doc->GetByStableId<ModuleInfo>(stableId);
+                    const auto stableKey{ModuleInfo::GetStableKey(processId, cached.name)};
+                    auto mi = doc->GetByStableKey<ModuleInfo>(stableKey);
                     if (mi == nullptr)
                     {
                         mi = doc->Append<ModuleInfo>(DBG_NEW ModuleInfo{processId, cached.name});
@@ -120,8 +120,8 @@ namespace pserv
                         cached.size = moduleInfo.SizeOfImage;
                         s_moduleCache[wPath] = cached;
 
-                        const auto stableId{ModuleInfo::GetStableID(processId, moduleName)};
-                        auto mi = doc->GetByStableId<ModuleInfo>(stableId);
+                        const auto stableKey{ModuleInfo::GetStableKey(processId, moduleName)};
+                        auto mi = doc->GetByStableKey<ModuleInfo>(stableKey);
                         if (mi == nullptr)
                         {
                             mi = doc->Append<ModuleInfo>(DBG_NEW ModuleInfo{processId, moduleName});
@@ -92,8 +92,8 @@ namespace pserv
             std::string processName = GetProcessNameFromPid(pid);
 
             const auto protocol = NetworkProtocol::TCP;
-            const auto stableId{NetworkConnectionInfo::GetStableID(protocol, localAddr, localPort)};
-            auto nci = doc->GetByStableId<NetworkConnectionInfo>(stableId);
+            const auto stableKey{NetworkConnectionInfo::GetStableKey(protocol, localAddr, localPort)};
+            auto nci = doc->GetByStableKey<NetworkConnectionInfo>(stableKey);
             if (nci == nullptr)
             {
                 nci = doc->Append<NetworkConnectionInfo>(DBG_NEW NetworkConnectionInfo{protocol, localAddr, localPort});
@@ -138,8 +138,8 @@ namespace pserv
             std::string processName = GetProcessNameFromPid(pid);
 
             const auto protocol = NetworkProtocol::TCPv6;
-            const auto stableId{NetworkConnectionInfo::GetStableID(protocol, localAddr, localPort)};
-            auto nci = doc->GetByStableId<NetworkConnectionInfo>(stableId);
+            const auto stableKey{NetworkConnectionInfo::GetStableKey(protocol, localAddr, localPort)};
+            auto nci = doc->GetByStableKey<NetworkConnectionInfo>(stableKey);
             if (nci == nullptr)
             {
                 nci = doc->Append<NetworkConnectionInfo>(DBG_NEW NetworkConnectionInfo{protocol, localAddr, localPort});
@@ -181,8 +181,8 @@ namespace pserv
 
             // UDP has no remote endpoint or state
             const auto protocol = NetworkProtocol::UDP;
-            const auto stableId{NetworkConnectionInfo::GetStableID(protocol, localAddr, localPort)};
-            auto nci = doc->GetByStableId<NetworkConnectionInfo>(stableId);
+            const auto stableKey{NetworkConnectionInfo::GetStableKey(protocol, localAddr, localPort)};
+            auto nci = doc->GetByStableKey<NetworkConnectionInfo>(stableKey);
             if (nci == nullptr)
             {
                 nci = doc->Append<NetworkConnectionInfo>(DBG_NEW NetworkConnectionInfo{protocol, localAddr, localPort});
@@ -223,8 +223,8 @@ namespace pserv
             std::string processName = GetProcessNameFromPid(pid);
 
             const auto protocol = NetworkProtocol::UDPv6;
-            const auto stableId{NetworkConnectionInfo::GetStableID(protocol, localAddr, localPort)};
-            auto nci = doc->GetByStableId<NetworkConnectionInfo>(stableId);
+            const auto stableKey{NetworkConnectionInfo::GetStableKey(protocol, localAddr, localPort)};
+            auto nci = doc->GetByStableKey<NetworkConnectionInfo>(stableKey);
             if (nci == nullptr)
             {
                 nci = doc->Append<NetworkConnectionInfo>(DBG_NEW NetworkConnectionInfo{protocol, localAddr, localPort});
@@ -0,0 +1,111 @@
+#include "precomp.h"
+#include <windows_api/process_details_cache.h>
+
+namespace pserv
+{
+    /// Threads Load() uses, see SetParallelism().
+    static std::atomic<size_t> g_detailsParallelism{ProcessDetailsCache::DEFAULT_PARALLELISM};
+
+    static uint64_t ToKeyTime(const FILETIME &fileTime)
+    {
+        return (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+    }
+
+    ProcessDetailsCache::ProcessDetailsCache(std::unique_ptr<ProcessDetailsProvider> pProvider)
+        : m_pProvider{std::move(pProvider)}
+    {
+    }
+
+    const ProcessDetails *ProcessDetailsCache::Get(DWORD pid, const FILETIME &creationTime, bool bLoad)
+    {
+        const Key key{pid, ToKeyTime(creationTime)};
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            if (!bLoad)
+            {
+                return nullptr;
+            }
+            it = m_entries.emplace(key, Entry{m_pProvider->Query(pid)}).first;
+        }
+        it->second.LastSeen = m_enumeration;
+        return &it->second.Details;
+    }
+
+    void ProcessDetailsCache::SetParallelism(size_t threadCount) noexcept
+    {
+        g_detailsParallelism = threadCount;
+    }
+
+    size_t ProcessDetailsCache::GetParallelism() noexcept
+    {
+        return g_detailsParallelism;
+    }
+
+    void ProcessDetailsCache::Load(std::span<const Instance> instances)
+    {
+        std::vector<Key> missing;
+        for (const auto &instance : instances)
+        {
+            const Key key{instance.Pid, ToKeyTime(instance.CreationTime)};
+            if (const auto it = m_entries.find(key); it != m_entries.end())
+            {
+                it->second.LastSeen = m_enumeration;
+            }
+            else
+            {
+                missing.push_back(key);
+            }
+        }
+        if (missing.empty())
+        {
+            return;
+        }
+
+        // One slot per process, so the workers share nothing but the index of the next one to read.
+        // A failed query leaves its slot empty: an exception escaping a thread would terminate us.
+        std::vector<ProcessDetails> slots(missing.size());
+        std::atomic<size_t> nextIndex{0};
+        const auto worker = [&]() {
+            for (size_t index = nextIndex++; index < missing.size(); index = nextIndex++)
+            {
+                try
+                {
+                    slots[index] = m_pProvider->Query(missing[index].Pid);
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Failed to read details of process {}: {}", missing[index].Pid, e.what());
+                }
+            }
+        };
+
+        const size_t threadCount = std::clamp<size_t>(GetParallelism(), 1, missing.size());
+        const auto startTime = std::chrono::steady_clock::now();
+        {
+            // jthread joins on destruction, also if starting a thread throws
+            std::vector<std::jthread> workers;
+            workers.reserve(threadCount - 1);
+            for (size_t i = 0; i + 1 < threadCount; ++i)
+            {
+                workers.emplace_back(worker);
+            }
+            worker();
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        spdlog::debug("Read details of {} processes on {} threads in {:.1f} ms", missing.size(), threadCount, elapsed.count() / 1000.0);
+
+        for (size_t index = 0; index < missing.size(); ++index)
+        {
+            m_entries.insert_or_assign(missing[index], Entry{std::move(slots[index]), m_enumeration});
+        }
+    }
+
+    void ProcessDetailsCache::EvictUnseen()
+    {
+        // Also drops the previous instance of a reused PID, which is never asked for again
+        std::erase_if(m_entries, [this](const auto &entry) { return entry.second.LastSeen != m_enumeration; });
+        ++m_enumeration;
+    }
+
+} // namespace pserv
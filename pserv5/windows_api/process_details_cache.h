@@ -0,0 +1,115 @@
+/// @file process_details_cache.h
+/// @brief Cache of the fields of a process that never change while it runs.
+///
+/// The owning user, image path and command line of a process are fixed when it
+/// starts, but reading them costs a token query, an account lookup and several
+/// reads of the process memory. ProcessDetailsCache reads them once per process
+/// instance - identified by PID and creation time, so a reused PID is not
+/// mistaken for the process that had it before - and forgets them once the
+/// process is gone. The reads themselves are done by a ProcessDetailsProvider.
+#pragma once
+
+namespace pserv
+{
+    /// @brief The fields of a process that do not change while it runs.
+    struct ProcessDetails final
+    {
+        std::string User;    ///< Account name if UserSid is empty.
+        std::string UserSid; ///< Owner SID in SDDL form; its name comes from SidNameCache.
+        std::string Path;
+        std::string CommandLine;
+    };
+
+    /// @brief Reads the ProcessDetails of a process (see ProcessManager::CreateDetailsProvider()).
+    /// Query() is called from several threads at once, see ProcessDetailsCache::Load().
+    class ProcessDetailsProvider
+    {
+    public:
+        virtual ~ProcessDetailsProvider() = default;
+
+        /// @brief Read the details of a process; fields that cannot be read are left empty.
+        /// @param pid Process ID.
+        virtual ProcessDetails Query(DWORD pid) const = 0;
+    };
+
+    /// @brief ProcessDetails of the running processes, keyed by PID and creation time.
+    ///
+    /// Not thread-safe: meant to be used by the refreshes of one controller, which never overlap.
+    class ProcessDetailsCache final
+    {
+    public:
+        /// @brief Default for SetParallelism(): more threads gained less than 10% in
+        /// tests/bench/process_details_bench.cpp, with the queries mostly waiting.
+        static constexpr size_t DEFAULT_PARALLELISM = 8;
+
+        /// @brief A process instance whose details Load() reads.
+        struct Instance final
+        {
+            DWORD Pid{0};
+            FILETIME CreationTime{};
+        };
+
+        explicit ProcessDetailsCache(std::unique_ptr<ProcessDetailsProvider> pProvider);
+
+        /// @brief Set the number of threads Load() queries the provider on (applies to all caches).
+        /// @param threadCount Number of threads; 0 or 1 reads the details on the calling thread.
+        static void SetParallelism(size_t threadCount) noexcept;
+
+        /// @brief Get the value set by SetParallelism().
+        static size_t GetParallelism() noexcept;
+
+        /// @brief Read the details of the process instances that are not cached yet, in parallel.
+        /// Each worker writes the details of the instances it picked into their own slot; the
+        /// cache itself is only filled on the calling thread afterwards, once the workers are done.
+        /// The entries count as seen in this enumeration, see EvictUnseen().
+        /// @param instances The process instances whose details are needed.
+        void Load(std::span<const Instance> instances);
+
+        /// @brief Get the details of a process instance, reading them if needed and allowed.
+        /// Marks the entry as seen in this enumeration, see EvictUnseen().
+        /// @param pid Process ID.
+        /// @param creationTime Creation time of the process (zero if unknown).
+        /// @param bLoad Query the provider if the details are not cached yet.
+        /// @return The cached details, or null if they are not cached and @p bLoad is false.
+        ///         Valid until the next EvictUnseen().
+        const ProcessDetails *Get(DWORD pid, const FILETIME &creationTime, bool bLoad);
+
+        /// @brief Forget the processes that were not passed to Get() since the last call.
+        /// Call after each complete enumeration of the processes.
+        void EvictUnseen();
+
+        /// @brief Get the number of cached process instances.
+        size_t GetSize() const noexcept
+        {
+            return m_entries.size();
+        }
+
+    private:
+        struct Key final
+        {
+            DWORD Pid{0};
+            uint64_t CreationTime{0};
+
+            bool operator==(const Key &other) const noexcept = default;
+        };
+
+        struct KeyHash final
+        {
+            size_t operator()(const Key &key) const noexcept
+            {
+                return std::hash<uint64_t>{}(key.CreationTime ^ (static_cast<uint64_t>(key.Pid) << 32));
+            }
+        };
+
+        struct Entry final
+        {
+            ProcessDetails Details;
+            uint64_t LastSeen{0}; ///< Enumeration that last asked for this process.
+        };
+
+        std::unique_ptr<ProcessDetailsProvider> m_pProvider;
+        std::unordered_map<Key, Entry, KeyHash> m_entries;
+        uint64_t m_enumeration{0}; ///< Incremented by EvictUnseen().
+    };
+
+} // namespace pserv
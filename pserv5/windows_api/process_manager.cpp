@@ -3,6 +3,8 @@
 #include <utils/string_utils.h>
 #include <utils/win32_error.h>
 #include <windows_api/process_manager.h>
+#include <windows_api/sid_name_cache.h>
+#include <windows_api/system_process_information.h>
 #include <core/data_object_container.h>
 
 #pragma comment(lib, "psapi.lib")
@@ -11,8 +13,8 @@
 namespace pserv
 {
 
-    // Helper to get user from process handle
-    static std::string GetProcessUser(HANDLE hProcess)
+    // Helper to get the user SID (in SDDL form) from process handle; see SidNameCache for its name
+    static std::string GetProcessUserSid(HANDLE hProcess)
     {
         wil::unique_handle hToken;
         if (!OpenProcessToken(hProcess, TOKEN_QUERY, &hToken))
@@ -38,20 +40,15 @@ namespace pserv
 
         TOKEN_USER *user = reinterpret_cast<TOKEN_USER *>(buffer.get());
 
-        // Resolve SID to name
-        wchar_t name[256];
-        wchar_t domain[256];
-        DWORD nameLen = sizeof(name) / sizeof(wchar_t);
-        DWORD domainLen = sizeof(domain) / sizeof(wchar_t);
-        SID_NAME_USE type;
-
-        if (!LookupAccountSidW(nullptr, user->User.Sid, name, &nameLen, domain, &domainLen, &type))
+        LPWSTR sidString = nullptr;
+        if (!ConvertSidToStringSidW(user->User.Sid, &sidString))
         {
-            LogWin32Error("LookupAccountSidW");
+            LogWin32Error("ConvertSidToStringSidW");
             return "";
         }
-
-        return std::format("{}\\{}", utils::WideToUtf8(domain), utils::WideToUtf8(name));
+        std::string result = utils::WideToUtf8(sidString);
+        LocalFree(sidString);
+        return result;
     }
 
     // Helper to get path
@@ -240,95 +237,211 @@ namespace pserv
         return "";
     }
 
-    void ProcessManager::EnumerateProcesses(DataObjectContainer *doc)
+    // Reads user, path and command line with the Win32 token, image name and PEB helpers above
+    class Win32ProcessDetailsProvider final : public ProcessDetailsProvider
     {
-        wil::unique_handle hSnapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
-        if (!hSnapshot)
+    public:
+        ProcessDetails Query(DWORD pid) const override
         {
-            LogWin32Error("CreateToolhelp32Snapshot");
-            return;
+            // PROCESS_QUERY_LIMITED_INFORMATION is enough for token and path, the command line needs PROCESS_VM_READ
+            wil::unique_handle hProcess(OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, pid));
+            if (!hProcess)
+            {
+                // Access denied or system process - common, log at debug level
+                LogExpectedWin32Error("OpenProcess", "PID {} for details", pid);
+                const bool bSystem{pid == 0 || pid == 4};
+                return {bSystem ? "SYSTEM" : "", "", "", ""};
+            }
+            return {"", GetProcessUserSid(hProcess.get()), GetProcessPathInternal(hProcess.get()), GetProcessCommandLine(hProcess.get())};
         }
+    };
 
-        PROCESSENTRY32W pe32;
-        pe32.dwSize = sizeof(PROCESSENTRY32W);
-
-        if (!Process32FirstW(hSnapshot.get(), &pe32))
+    // The account name is not cached with the details: it may arrive later, see SidNameCache
+    static std::string GetProcessUserName(const ProcessDetails &details)
+    {
+        if (details.UserSid.empty())
         {
-            LogWin32Error("Process32FirstW");
-            return;
+            return details.User;
         }
+#ifdef PSERV_CONSOLE_BUILD
+        // Printed right away, there is no later refresh to show the name
+        return SidNameCache::GetInstance().GetNameNow(details.UserSid);
+#else
+        return SidNameCache::GetInstance().GetName(details.UserSid);
+#endif
+    }
 
-        do
+    // Make sure the expensive fields are loaded if requested, preferably without reading them again.
+    // Failed reads count as loaded too, otherwise every refresh would retry them.
+    static void UpdateProcessDetails(ProcessInfo *pProcess, const ProcessDetailsRequest &request)
+    {
+        const bool bWanted{request.bAllProcesses || request.StableKeys.contains(pProcess->GetStableKey())};
+        if (request.pCache != nullptr)
         {
-            std::string name = utils::WideToUtf8(pe32.szExeFile);
-
-            const auto stableId{ProcessInfo::GetStableID(pe32.th32ProcessID)};
-            auto pProcess = doc->GetByStableId<ProcessInfo>(stableId);
-            if (pProcess == nullptr)
+            // Looked up even if not wanted, so processes loaded earlier stay cached
+            const auto *pDetails = request.pCache->Get(pProcess->GetPid(), pProcess->GetCreationTime(), bWanted);
+            if (pDetails != nullptr)
             {
-                pProcess = doc->Append<ProcessInfo>(DBG_NEW ProcessInfo{pe32.th32ProcessID, name});
+                pProcess->SetDetails(GetProcessUserName(*pDetails), pDetails->Path, pDetails->CommandLine);
             }
+        }
+        else if (bWanted && !pProcess->HasDetails())
+        {
+            const auto details = Win32ProcessDetailsProvider{}.Query(pProcess->GetPid());
+            pProcess->SetDetails(GetProcessUserName(details), details.Path, details.CommandLine);
+        }
+    }
 
-            pProcess->SetParentPid(pe32.th32ParentProcessID);
-            pProcess->SetThreadCount(pe32.cntThreads);
+    std::unique_ptr<ProcessDetailsProvider> ProcessManager::CreateDetailsProvider()
+    {
+        return std::make_unique<Win32ProcessDetailsProvider>();
+    }
+
+    // From winternl.h
+    constexpr ULONG SYSTEM_PROCESS_INFORMATION_CLASS = 5; // SystemProcessInformation
+    constexpr NTSTATUS STATUS_INFO_LENGTH_MISMATCH_VALUE = static_cast<NTSTATUS>(0xC0000004L);
+
+    typedef NTSTATUS(NTAPI *pfnNtQuerySystemInformation)(
+        ULONG SystemInformationClass, PVOID SystemInformation, ULONG SystemInformationLength, PULONG ReturnLength);
+
+    // Fill the buffer with the SystemProcessInformation of all processes
+    // @return the number of bytes written, 0 on failure
+    static size_t QuerySystemProcessInformation(std::vector<std::byte> &buffer)
+    {
+        static auto NtQuerySystemInformation = (pfnNtQuerySystemInformation)GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation");
+        if (!NtQuerySystemInformation)
+        {
+            spdlog::error("NtQuerySystemInformation not found in ntdll.dll");
+            return 0;
+        }
 
-            // Open process to get more info
-            // PROCESS_QUERY_LIMITED_INFORMATION is enough for Token, Path, Priority, etc. on Vista+
-            wil::unique_handle hProcess(OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, pe32.th32ProcessID));
+        if (buffer.empty())
+        {
+            buffer.resize(256 * 1024);
+        }
 
-            if (hProcess)
+        // Processes may start between the size query and the next call, so allow for a few more
+        for (int attempt = 0; attempt < 5; ++attempt)
+        {
+            ULONG length = 0;
+            const NTSTATUS status = NtQuerySystemInformation(SYSTEM_PROCESS_INFORMATION_CLASS, buffer.data(), static_cast<ULONG>(buffer.size()), &length);
+            if (NT_SUCCESS(status))
+            {
+                return length;
+            }
+            if (status != STATUS_INFO_LENGTH_MISMATCH_VALUE)
             {
-                pProcess->SetUser(GetProcessUser(hProcess.get()));
-                pProcess->SetPath(GetProcessPathInternal(hProcess.get()));
-                pProcess->SetPriorityClass(GetPriorityClass(hProcess.get()));
-                pProcess->SetCommandLine(GetProcessCommandLine(hProcess.get()));
+                spdlog::error("NtQuerySystemInformation(SystemProcessInformation) failed: NTSTATUS 0x{:08X}", static_cast<DWORD>(status));
+                return 0;
+            }
+            buffer.resize(std::max<size_t>(length, buffer.size()) + 64 * 1024);
+        }
+        spdlog::error("NtQuerySystemInformation(SystemProcessInformation): buffer kept growing");
+        return 0;
+    }
 
-                DWORD handleCount = 0;
-                if (!GetProcessHandleCount(hProcess.get(), &handleCount))
-                {
-                    LogWin32Error("GetProcessHandleCount", "PID {}", pe32.th32ProcessID);
-                }
-                else
-                {
-                    pProcess->SetHandleCount(handleCount);
-                }
+    // Priority class for the base priority reported by the kernel. The classes start processes at
+    // 4, 6, 8, 10, 13 and 24, but the base priority can be off those levels (raised for the foreground
+    // process, or set directly with NtSetInformationProcess), so take the nearest class, the lower one
+    // on a tie. 0 for the System Idle Process, which has no class.
+    static DWORD GetPriorityClassFromBasePriority(int32_t basePriority)
+    {
+        if (basePriority <= 0)
+            return 0;
+        if (basePriority <= 5)
+            return IDLE_PRIORITY_CLASS;
+        if (basePriority <= 7)
+            return BELOW_NORMAL_PRIORITY_CLASS;
+        if (basePriority <= 9)
+            return NORMAL_PRIORITY_CLASS;
+        if (basePriority <= 11)
+            return ABOVE_NORMAL_PRIORITY_CLASS;
+        if (basePriority <= 15)
+            return HIGH_PRIORITY_CLASS; // the top of the dynamic range
+        return REALTIME_PRIORITY_CLASS; // 16-31
+    }
 
-                PROCESS_MEMORY_COUNTERS_EX pmc;
-                if (!GetProcessMemoryInfo(hProcess.get(), (PROCESS_MEMORY_COUNTERS *)&pmc, sizeof(pmc)))
-                {
-                    LogWin32Error("GetProcessMemoryInfo", "PID {}", pe32.th32ProcessID);
-                }
-                else
-                {
-                    pProcess->SetWorkingSetSize(pmc.WorkingSetSize);
-                    pProcess->SetPeakWorkingSetSize(pmc.PeakWorkingSetSize);
-                    pProcess->SetPrivatePageCount(pmc.PrivateUsage);
+    static FILETIME ToFileTime(uint64_t value)
+    {
+        return {static_cast<DWORD>(value), static_cast<DWORD>(value >> 32)};
+    }
 
-                    // Set extended memory stats
-                    pProcess->SetMemoryExtras(pmc.QuotaPagedPoolUsage, pmc.QuotaNonPagedPoolUsage, pmc.PageFaultCount);
-                }
+    void ProcessManager::EnumerateProcesses(DataObjectContainer *doc, const ProcessDetailsRequest &request)
+    {
+        // One system call for the counters of all processes, instead of opening each of them
+        std::vector<std::byte> buffer;
+        const size_t length = QuerySystemProcessInformation(buffer);
+        if (length == 0)
+        {
+            return;
+        }
 
-                FILETIME creation, exit, kernel, user;
-                if (!GetProcessTimes(hProcess.get(), &creation, &exit, &kernel, &user))
-                {
-                    LogWin32Error("GetProcessTimes", "PID {}", pe32.th32ProcessID);
-                }
-                else
-                {
-                    pProcess->SetTimes(creation, exit, kernel, user);
-                }
+        std::vector<SystemProcessRecord> records;
+        const bool bComplete = ParseSystemProcessInformation(std::span{buffer.data(), length}, records);
+        if (!bComplete)
+        {
+            spdlog::warn("Process list truncated to {} processes", records.size());
+        }
+
+        // Counters first, for all processes; user, path and command line of those that need them are
+        // then read in parallel, and set on the objects on this thread (the container is not thread-safe)
+        std::vector<ProcessInfo *> processes;
+        std::vector<ProcessDetailsCache::Instance> instancesToLoad;
+        processes.reserve(records.size());
+        for (const auto &record : records)
+        {
+            const auto stableKey{ProcessInfo::GetStableKey(record.ProcessId)};
+            auto pProcess = doc->GetByStableKey<ProcessInfo>(stableKey);
+            if (pProcess == nullptr)
+            {
+                // The idle process has no image name; Toolhelp calls it "[System Process]"
+                std::string name = record.ProcessId == 0
+                                       ? std::string{"[System Process]"}
+                                       : utils::WideToUtf8(std::wstring_view{reinterpret_cast<const wchar_t *>(record.ImageName.data()), record.ImageName.size()});
+                pProcess = doc->Append<ProcessInfo>(DBG_NEW ProcessInfo{record.ProcessId, name});
             }
-            else
+
+            pProcess->SetParentPid(record.ParentProcessId);
+            pProcess->SetThreadCount(record.ThreadCount);
+            pProcess->SetPriorityClass(GetPriorityClassFromBasePriority(record.BasePriority));
+            pProcess->SetHandleCount(record.HandleCount);
+            pProcess->SetSessionId(record.SessionId);
+            pProcess->SetVirtualSize(static_cast<SIZE_T>(record.VirtualSize));
+            pProcess->SetWorkingSetSize(static_cast<SIZE_T>(record.WorkingSetSize));
+            pProcess->SetPeakWorkingSetSize(static_cast<SIZE_T>(record.PeakWorkingSetSize));
+            pProcess->SetPrivatePageCount(static_cast<SIZE_T>(record.PrivateBytes));
+            pProcess->SetMemoryExtras(static_cast<SIZE_T>(record.PagedPoolUsage), static_cast<SIZE_T>(record.NonPagedPoolUsage), record.PageFaultCount);
+
+            // A different creation time means the PID was reused: the loaded fields belong to the old process
+            const FILETIME creation{ToFileTime(record.CreateTime)};
+            if (pProcess->HasDetails() && CompareFileTime(&creation, &pProcess->GetCreationTime()) != 0)
             {
-                // Access denied or system process - common, log at debug level
-                LogExpectedWin32Error("OpenProcess", "PID {} during enumeration", pe32.th32ProcessID);
+                pProcess->ClearDetails();
+            }
+            pProcess->SetTimes(creation, FILETIME{}, ToFileTime(record.KernelTime), ToFileTime(record.UserTime));
 
-                if (pe32.th32ProcessID == 0 || pe32.th32ProcessID == 4)
-                {
-                    pProcess->SetUser("SYSTEM");
-                }
+            processes.push_back(pProcess);
+            if (request.pCache != nullptr && (request.bAllProcesses || request.StableKeys.contains(stableKey)))
+            {
+                instancesToLoad.push_back({record.ProcessId, creation});
             }
-        } while (Process32NextW(hSnapshot.get(), &pe32));
+        }
+
+        // Only user, path and command line still need the processes to be opened
+        if (request.pCache != nullptr)
+        {
+            request.pCache->Load(instancesToLoad);
+        }
+        for (auto *pProcess : processes)
+        {
+            UpdateProcessDetails(pProcess, request);
+        }
+
+        // A truncated list would evict the details of processes that still run
+        if (request.pCache != nullptr && bComplete)
+        {
+            request.pCache->EvictUnseen();
+        }
     }
 
     bool ProcessManager::TerminateProcessById(DWORD pid)
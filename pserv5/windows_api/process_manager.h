@@ -1,23 +1,45 @@
 /// @file process_manager.h
 /// @brief Windows process enumeration and management API wrapper.
 ///
-/// Provides process listing via Tool Help API and process control
+/// Provides process listing via NtQuerySystemInformation and process control
 /// operations like termination and priority changes.
 #pragma once
+#include <core/stable_key.h>
+#include <windows_api/process_details_cache.h>
 
 namespace pserv
 {
     class DataObjectContainer;
 
+    /// @brief Selects the processes whose expensive fields are loaded by EnumerateProcesses().
+    ///
+    /// The owning user, path and command line cost a token query, an account lookup and
+    /// several reads of the process memory each. Most of them are never looked at, so
+    /// the UI asks for the rows on screen only (see DataController::SetObjectsOfInterest()).
+    struct ProcessDetailsRequest final
+    {
+        bool bAllProcesses{true};                                 ///< Load every process, ignoring StableKeys.
+        std::unordered_set<StableKey, StableKeyHash> StableKeys; ///< Processes to load otherwise.
+        /// Details read by earlier enumerations, reused for the same process instance. May be null,
+        /// then nothing is reused; otherwise its processes that no longer run are evicted.
+        ProcessDetailsCache *pCache{nullptr};
+    };
+
     /// @brief Namespace for process management functions.
     ///
-    /// Uses CreateToolhelp32Snapshot for enumeration and OpenProcess
-    /// for control operations.
+    /// Uses NtQuerySystemInformation for enumeration and OpenProcess
+    /// for details and control operations.
     namespace ProcessManager
     {
         /// @brief Enumerate all running processes into a container.
+        /// Counters, times and priority are read for every process; user, path and command line
+        /// only as selected by the request (see ProcessInfo::HasDetails()).
         /// @param doc Container to populate with ProcessInfo objects.
-        void EnumerateProcesses(DataObjectContainer *doc);
+        /// @param request Processes whose expensive fields are needed; all by default.
+        void EnumerateProcesses(DataObjectContainer *doc, const ProcessDetailsRequest &request = {});
+
+        /// @brief Create the provider that reads user, path and command line of a process.
+        std::unique_ptr<ProcessDetailsProvider> CreateDetailsProvider();
 
         /// @brief Terminate a process by its ID.
         /// @param pid Process ID to terminate.
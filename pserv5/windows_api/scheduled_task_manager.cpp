@@ -248,8 +248,8 @@ namespace pserv
             name = name.substr(lastSlash + 1);
         }
 
-        const auto stableId{ScheduledTaskInfo::GetStableID(name)};
-        auto sti = doc->GetByStableId<ScheduledTaskInfo>(stableId);
+        const auto stableKey{ScheduledTaskInfo::GetStableKey(name)};
+        auto sti = doc->GetByStableKey<ScheduledTaskInfo>(stableKey);
         if (sti == nullptr)
         {
             sti = doc->Append<ScheduledTaskInfo>(DBG_NEW ScheduledTaskInfo{name});
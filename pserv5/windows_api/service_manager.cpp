@@ -110,8 +110,8 @@ namespace pserv
         for (DWORD i = 0; i < servicesReturned; ++i)
         {
             const auto serviceName{utils::WideToUtf8(pServices[i].lpServiceName)};
-            const auto stableId{ServiceInfo::GetStableID(serviceName)};
-            auto info = doc->GetByStableId<ServiceInfo>(stableId);
+            const auto stableKey{ServiceInfo::GetStableKey(serviceName)};
+            auto info = doc->GetByStableKey<ServiceInfo>(stableKey);
             if (info == nullptr)
             {
                 info = doc->Append<ServiceInfo>(DBG_NEW ServiceInfo{serviceName});
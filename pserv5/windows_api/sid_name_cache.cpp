@@ -0,0 +1,170 @@
+#include "precomp.h"
+#include <utils/string_utils.h>
+#include <utils/win32_error.h>
+#include <windows_api/sid_name_cache.h>
+
+#pragma comment(lib, "advapi32.lib")
+
+namespace pserv
+{
+    // Looks up names on the local machine with LookupAccountSidW (which asks the domain for domain accounts)
+    class Win32SidResolver final : public SidResolver
+    {
+    public:
+        std::optional<std::string> LookupAccountName(const std::string &sid) const override
+        {
+            PSID pSid = nullptr;
+            if (!ConvertStringSidToSidW(utils::Utf8ToWide(sid).c_str(), &pSid))
+            {
+                LogWin32Error("ConvertStringSidToSidW", "SID {}", sid);
+                return std::nullopt;
+            }
+
+            wchar_t name[256];
+            wchar_t domain[256];
+            DWORD nameLen = sizeof(name) / sizeof(wchar_t);
+            DWORD domainLen = sizeof(domain) / sizeof(wchar_t);
+            SID_NAME_USE type;
+            const BOOL bFound = LookupAccountSidW(nullptr, pSid, name, &nameLen, domain, &domainLen, &type);
+            LocalFree(pSid);
+
+            if (!bFound)
+            {
+                // Deleted accounts, unreachable domains, logon session SIDs. Not logged here:
+                // after SidNameCache::Shutdown() this may return during static destruction.
+                return std::nullopt;
+            }
+            return std::format("{}\\{}", utils::WideToUtf8(domain), utils::WideToUtf8(name));
+        }
+    };
+
+    SidNameCache &SidNameCache::GetInstance()
+    {
+        static SidNameCache theSidNameCache{std::make_unique<Win32SidResolver>()};
+        return theSidNameCache;
+    }
+
+    SidNameCache::SidNameCache(std::unique_ptr<SidResolver> pResolver, std::chrono::steady_clock::duration nameTtl, std::chrono::steady_clock::duration missingNameTtl)
+        : m_pState{std::make_shared<State>(std::move(pResolver), nameTtl, missingNameTtl)}
+    {
+    }
+
+    SidNameCache::~SidNameCache()
+    {
+        Shutdown();
+    }
+
+    void SidNameCache::Shutdown()
+    {
+        bool bLookingUp;
+        {
+            std::lock_guard<std::mutex> lock{m_pState->Mutex};
+            m_pState->bShutdown = true;
+            m_pState->Queue.clear();
+            bLookingUp = m_pState->bLookingUp;
+        }
+        m_pState->Wakeup.notify_one();
+        if (m_worker.joinable())
+        {
+            // An idle worker ends right away. One in the resolver would block us until the lookup
+            // returns; it keeps the state alive and ends after the lookup instead.
+            if (bLookingUp)
+                m_worker.detach();
+            else
+                m_worker.join();
+        }
+    }
+
+    std::string SidNameCache::GetName(const std::string &sid)
+    {
+        std::unique_lock<std::mutex> lock{m_pState->Mutex};
+        auto &entry = m_pState->Entries[sid];
+        // Read before unlocking: the worker may store the new name right after
+        std::string name = entry.Name.value_or(sid);
+        if (!entry.bQueued && !m_pState->bShutdown && std::chrono::steady_clock::now() >= entry.Expiry)
+        {
+            entry.bQueued = true;
+            m_pState->Queue.push_back(sid);
+            if (!m_worker.joinable())
+            {
+                m_worker = std::thread{[pState = m_pState]() { WorkerMain(*pState); }};
+            }
+            lock.unlock();
+            m_pState->Wakeup.notify_one();
+        }
+        return name;
+    }
+
+    std::string SidNameCache::GetNameNow(const std::string &sid)
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_pState->Mutex};
+            const auto it = m_pState->Entries.find(sid);
+            if (it != m_pState->Entries.end() && std::chrono::steady_clock::now() < it->second.Expiry)
+            {
+                return it->second.Name.value_or(sid);
+            }
+        }
+
+        auto name = m_pState->pResolver->LookupAccountName(sid);
+        std::lock_guard<std::mutex> lock{m_pState->Mutex};
+        m_pState->Store(sid, std::move(name));
+        return m_pState->Entries[sid].Name.value_or(sid);
+    }
+
+    SidNameCache::State::State(std::unique_ptr<SidResolver> pResolver, std::chrono::steady_clock::duration nameTtl, std::chrono::steady_clock::duration missingNameTtl)
+        : pResolver{std::move(pResolver)},
+          NameTtl{nameTtl},
+          MissingNameTtl{missingNameTtl}
+    {
+    }
+
+    void SidNameCache::State::Store(const std::string &sid, std::optional<std::string> name)
+    {
+        auto &entry = Entries[sid];
+        if (name)
+        {
+            entry.Expiry = std::chrono::steady_clock::now() + NameTtl;
+            entry.Name = std::move(name);
+        }
+        else
+        {
+            // Keep the last name found: the lookup may fail only for now (e.g. an unreachable domain).
+            // Retry as soon as for a SID that never had one.
+            entry.Expiry = std::chrono::steady_clock::now() + MissingNameTtl;
+        }
+    }
+
+    void SidNameCache::WorkerMain(State &state)
+    {
+        std::unique_lock<std::mutex> lock{state.Mutex};
+        while (true)
+        {
+            state.Wakeup.wait(lock, [&state]() { return state.bShutdown || !state.Queue.empty(); });
+            if (state.bShutdown)
+                return;
+
+            std::vector<std::string> sids;
+            sids.swap(state.Queue);
+            for (const auto &sid : sids)
+            {
+                state.bLookingUp = true;
+                lock.unlock();
+                const auto startTime = std::chrono::steady_clock::now();
+                auto name = state.pResolver->LookupAccountName(sid);
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+                lock.lock();
+                state.bLookingUp = false;
+
+                // After Shutdown() logging may already be gone
+                if (state.bShutdown)
+                    return;
+                spdlog::debug("Looked up SID {} as '{}' in {} ms", sid, name.value_or(""), elapsed.count());
+                state.Store(sid, std::move(name));
+                state.Entries[sid].bQueued = false;
+                state.Revision.fetch_add(1, std::memory_order_release);
+            }
+        }
+    }
+
+} // namespace pserv
@@ -0,0 +1,110 @@
+/// @file sid_name_cache.h
+/// @brief Process-wide cache of the account names of security identifiers (SIDs).
+///
+/// LookupAccountSidW may have to ask a domain controller, which takes
+/// milliseconds per call, or much longer if it is unreachable. Only a handful
+/// of distinct SIDs own all the processes on a machine, so their names are
+/// cached: SIDs without a name (deleted accounts, unreachable domains) too,
+/// both for a limited time, so renamed accounts and recovered domains show up
+/// eventually. Names are looked up on a worker thread; until a name has
+/// arrived, the SID itself (in SDDL form, "S-1-5-21-...") stands in for it.
+/// A name that was found once is kept if a later lookup fails.
+/// The lookups are done by a SidResolver, so tests can use an in-memory directory.
+#pragma once
+
+namespace pserv
+{
+    /// @brief Looks up the account name of a SID.
+    class SidResolver
+    {
+    public:
+        virtual ~SidResolver() = default;
+
+        /// @brief Look up the account name of a SID; may block.
+        /// @param sid The SID in SDDL form, e.g. "S-1-5-18".
+        /// @return "DOMAIN\\user", or std::nullopt if the SID has no account name.
+        virtual std::optional<std::string> LookupAccountName(const std::string &sid) const = 0;
+    };
+
+    /// @brief Cache of account names by SID, filled in the background.
+    class SidNameCache final
+    {
+    public:
+        /// @brief How long a name is used before it is looked up again.
+        static constexpr std::chrono::minutes NAME_TTL{10};
+        /// @brief How long a SID without a name is not looked up again.
+        static constexpr std::chrono::minutes MISSING_NAME_TTL{1};
+
+        /// @brief Get the cache shared by all managers, which looks up names with LookupAccountSidW.
+        static SidNameCache &GetInstance();
+
+        explicit SidNameCache(std::unique_ptr<SidResolver> pResolver,
+            std::chrono::steady_clock::duration nameTtl = NAME_TTL,
+            std::chrono::steady_clock::duration missingNameTtl = MISSING_NAME_TTL);
+        ~SidNameCache(); ///< Calls Shutdown().
+
+        SidNameCache(const SidNameCache &) = delete;
+        SidNameCache &operator=(const SidNameCache &) = delete;
+        SidNameCache(SidNameCache &&) = delete;
+        SidNameCache &operator=(SidNameCache &&) = delete;
+
+        /// @brief Get the account name of a SID without blocking.
+        /// SIDs that are unknown or expired are looked up in the background; see GetRevision().
+        /// @param sid The SID in SDDL form.
+        /// @return The account name; the SID itself if it has none or it has not arrived yet.
+        ///         An expired name is returned until its new lookup finished.
+        std::string GetName(const std::string &sid);
+
+        /// @brief Get the account name of a SID, looking it up on the calling thread if needed.
+        /// For one-shot output, e.g. in pservc, where there is no later refresh to show it.
+        /// @return The account name, or the SID itself if it has none.
+        std::string GetNameNow(const std::string &sid);
+
+        /// @brief Stop looking up names in the background; GetName() only returns cached names from now on.
+        /// Does not wait for a lookup in progress, which may take long for an unreachable domain:
+        /// the worker then finishes it on its own, and drops the result.
+        /// Call it on application shutdown, before logging is torn down.
+        void Shutdown();
+
+        /// @brief Counter that changes whenever a background lookup finished.
+        /// Compare with an earlier value to decide whether names returned since then are outdated.
+        uint64_t GetRevision() const noexcept
+        {
+            return m_pState->Revision.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Entry final
+        {
+            std::optional<std::string> Name;              ///< Last name found; std::nullopt if unknown or the SID has none.
+            std::chrono::steady_clock::time_point Expiry; ///< Look up again from then on; initially expired.
+            bool bQueued{false};                          ///< A background lookup is queued or running.
+        };
+
+        /// Everything the worker uses. The worker shares ownership, so it can outlive the cache (see Shutdown()).
+        struct State final
+        {
+            State(std::unique_ptr<SidResolver> pResolver, std::chrono::steady_clock::duration nameTtl, std::chrono::steady_clock::duration missingNameTtl);
+
+            void Store(const std::string &sid, std::optional<std::string> name); // call with Mutex held
+
+            const std::unique_ptr<SidResolver> pResolver;
+            const std::chrono::steady_clock::duration NameTtl;
+            const std::chrono::steady_clock::duration MissingNameTtl;
+
+            std::mutex Mutex;                               ///< Guards everything below except Revision.
+            std::condition_variable Wakeup;                 ///< Signals a queued lookup or shutdown.
+            std::unordered_map<std::string, Entry> Entries; ///< Keyed by SID in SDDL form.
+            std::vector<std::string> Queue;                 ///< SIDs for the worker to look up.
+            bool bLookingUp{false};                         ///< The worker is in the resolver.
+            bool bShutdown{false};                          ///< Set by Shutdown().
+            std::atomic<uint64_t> Revision{0};              ///< See GetRevision().
+        };
+
+        static void WorkerMain(State &state);
+
+        const std::shared_ptr<State> m_pState;
+        std::thread m_worker; ///< Started with the first background lookup.
+    };
+
+} // namespace pserv
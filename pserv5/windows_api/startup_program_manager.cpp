@@ -112,8 +112,8 @@ namespace pserv
             std::string name = utils::WideToUtf8(valueName);
             std::string command = utils::WideToUtf8(reinterpret_cast<wchar_t *>(valueData));
 
-            const auto stableId{StartupProgramInfo::GetStableID(name, type, scope)};
-            auto program = doc->GetByStableId<StartupProgramInfo>(stableId);
+            const auto stableKey{StartupProgramInfo::GetStableKey(name, type, scope)};
+            auto program = doc->GetByStableKey<StartupProgramInfo>(stableKey);
             if (program == nullptr)
             {
                 program = doc->Append<StartupProgramInfo>(DBG_NEW StartupProgramInfo{name, command, locationDesc, type, scope, true});
@@ -157,8 +157,8 @@ namespace pserv
 
                 std::string command = utils::WideToUtf8(targetPath);
                 const auto type = StartupProgramType::StartupFolder;
-                const auto stableId{StartupProgramInfo::GetStableID(fileName, type, scope)};
-                auto program = doc->GetByStableId<StartupProgramInfo>(stableId);
+                const auto stableKey{StartupProgramInfo::GetStableKey(fileName, type, scope)};
+                auto program = doc->GetByStableKey<StartupProgramInfo>(stableKey);
                 if (program == nullptr)
                 {
                     program = doc->Append<StartupProgramInfo>(DBG_NEW StartupProgramInfo{fileName, command, locationDesc, type, scope, true});
@@ -0,0 +1,132 @@
+#include "precomp.h"
+#include <windows_api/system_process_information.h>
+
+namespace pserv
+{
+    // Layout of SYSTEM_PROCESS_INFORMATION (winternl.h only declares part of it), spelled with
+    // portable types: Pointer is the pointer-sized integer of the Windows that wrote the buffer,
+    // and the natural alignment of the members gives its layout on any compiler.
+    // The entry is followed by its SYSTEM_THREAD_INFORMATION array, which is skipped.
+    template <typename Pointer> struct UnicodeStringLayout final
+    {
+        uint16_t Length; ///< In bytes, without terminator.
+        uint16_t MaximumLength;
+        Pointer Buffer;
+    };
+
+    template <typename Pointer> struct SystemProcessInformationEntry final
+    {
+        uint32_t NextEntryOffset; ///< 0 for the last entry.
+        uint32_t NumberOfThreads;
+        int64_t WorkingSetPrivateSize;
+        uint32_t HardFaultCount;
+        uint32_t NumberOfThreadsHighWatermark;
+        uint64_t CycleTime;
+        int64_t CreateTime;
+        int64_t UserTime;
+        int64_t KernelTime;
+        UnicodeStringLayout<Pointer> ImageName;
+        int32_t BasePriority;
+        Pointer UniqueProcessId;
+        Pointer InheritedFromUniqueProcessId;
+        uint32_t HandleCount;
+        uint32_t SessionId;
+        Pointer UniqueProcessKey;
+        Pointer PeakVirtualSize;
+        Pointer VirtualSize;
+        uint32_t PageFaultCount;
+        Pointer PeakWorkingSetSize;
+        Pointer WorkingSetSize;
+        Pointer QuotaPeakPagedPoolUsage;
+        Pointer QuotaPagedPoolUsage;
+        Pointer QuotaPeakNonPagedPoolUsage;
+        Pointer QuotaNonPagedPoolUsage;
+        Pointer PagefileUsage;
+        Pointer PeakPagefileUsage;
+        Pointer PrivatePageCount;
+        int64_t ReadOperationCount;
+        int64_t WriteOperationCount;
+        int64_t OtherOperationCount;
+        int64_t ReadTransferCount;
+        int64_t WriteTransferCount;
+        int64_t OtherTransferCount;
+    };
+    static_assert(sizeof(SystemProcessInformationEntry<uint64_t>) == 0x100, "x64 SYSTEM_PROCESS_INFORMATION layout mismatch");
+    static_assert(sizeof(SystemProcessInformationEntry<uint32_t>) == 0xB8, "x86 SYSTEM_PROCESS_INFORMATION layout mismatch");
+
+    // The image name is an absolute pointer into the buffer; anything else yields an empty name
+    template <typename Pointer>
+    static std::u16string_view GetImageName(std::span<const std::byte> buffer, uint64_t bufferAddress, const UnicodeStringLayout<Pointer> &name)
+    {
+        if (name.Length == 0 || name.Length % 2 != 0 || name.Buffer < bufferAddress)
+        {
+            return {};
+        }
+        const uint64_t offset = name.Buffer - bufferAddress;
+        if (offset % alignof(char16_t) != 0 || offset > buffer.size() || buffer.size() - offset < name.Length)
+        {
+            return {};
+        }
+        return {reinterpret_cast<const char16_t *>(buffer.data() + offset), name.Length / sizeof(char16_t)};
+    }
+
+    template <typename Pointer>
+    static bool ParseEntries(std::span<const std::byte> buffer, uint64_t bufferAddress, std::vector<SystemProcessRecord> &records)
+    {
+        using Entry = SystemProcessInformationEntry<Pointer>;
+        size_t offset = 0;
+        while (true)
+        {
+            if (buffer.size() - offset < sizeof(Entry))
+            {
+                spdlog::error("SystemProcessInformation entry at offset {} exceeds the buffer of {} bytes", offset, buffer.size());
+                return false;
+            }
+
+            // Copied out, so the buffer needs no particular alignment
+            Entry entry;
+            std::memcpy(&entry, buffer.data() + offset, sizeof(entry));
+
+            SystemProcessRecord &record = records.emplace_back();
+            record.ProcessId = static_cast<uint32_t>(entry.UniqueProcessId);
+            record.ParentProcessId = static_cast<uint32_t>(entry.InheritedFromUniqueProcessId);
+            record.ThreadCount = entry.NumberOfThreads;
+            record.HandleCount = entry.HandleCount;
+            record.SessionId = entry.SessionId;
+            record.PageFaultCount = entry.PageFaultCount;
+            record.BasePriority = entry.BasePriority;
+            record.CreateTime = static_cast<uint64_t>(entry.CreateTime);
+            record.UserTime = static_cast<uint64_t>(entry.UserTime);
+            record.KernelTime = static_cast<uint64_t>(entry.KernelTime);
+            record.VirtualSize = entry.VirtualSize;
+            record.WorkingSetSize = entry.WorkingSetSize;
+            record.PeakWorkingSetSize = entry.PeakWorkingSetSize;
+            record.PrivateBytes = entry.PagefileUsage;
+            record.PagedPoolUsage = entry.QuotaPagedPoolUsage;
+            record.NonPagedPoolUsage = entry.QuotaNonPagedPoolUsage;
+            record.ImageName = GetImageName(buffer, bufferAddress, entry.ImageName);
+
+            if (entry.NextEntryOffset == 0)
+            {
+                return true;
+            }
+            if (entry.NextEntryOffset < sizeof(Entry) || entry.NextEntryOffset > buffer.size() - offset)
+            {
+                spdlog::error("SystemProcessInformation entry at offset {} has an invalid next offset {}", offset, entry.NextEntryOffset);
+                return false;
+            }
+            offset += entry.NextEntryOffset;
+        }
+    }
+
+    bool ParseSystemProcessInformation(std::span<const std::byte> buffer, uint64_t bufferAddress, SystemProcessInformationLayout layout, std::vector<SystemProcessRecord> &records)
+    {
+        records.clear();
+        if (layout == SystemProcessInformationLayout::X64)
+        {
+            return ParseEntries<uint64_t>(buffer, bufferAddress, records);
+        }
+        return ParseEntries<uint32_t>(buffer, bufferAddress, records);
+    }
+
+} // namespace pserv
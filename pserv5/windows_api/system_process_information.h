@@ -0,0 +1,64 @@
+/// @file system_process_information.h
+/// @brief Parser for the process list returned by NtQuerySystemInformation.
+///
+/// NtQuerySystemInformation(SystemProcessInformation) fills a buffer with one
+/// variable-length entry per process: identity, thread and handle counts,
+/// memory counters and CPU times, all without opening a single process. The
+/// parser here only reads that buffer, so it does not depend on Windows and
+/// can be checked against captured or synthetic buffers of either pointer
+/// size on any platform (see tests/system_process_information_test.cpp); the
+/// system call itself lives in process_manager.cpp.
+#pragma once
+
+namespace pserv
+{
+    /// @brief The fields of one process parsed from a SystemProcessInformation buffer.
+    struct SystemProcessRecord final
+    {
+        uint32_t ProcessId{0};
+        uint32_t ParentProcessId{0};
+        uint32_t ThreadCount{0};
+        uint32_t HandleCount{0};
+        uint32_t SessionId{0};
+        uint32_t PageFaultCount{0};
+        int32_t BasePriority{0};    ///< Base priority level (8 = normal), not a priority class.
+        uint64_t CreateTime{0};     ///< FILETIME units (100 ns since 1601); 0 for the idle process.
+        uint64_t UserTime{0};       ///< 100 ns units.
+        uint64_t KernelTime{0};     ///< 100 ns units.
+        uint64_t VirtualSize{0};
+        uint64_t WorkingSetSize{0};
+        uint64_t PeakWorkingSetSize{0};
+        uint64_t PrivateBytes{0};   ///< Committed private memory, as PROCESS_MEMORY_COUNTERS_EX::PrivateUsage.
+        uint64_t PagedPoolUsage{0};
+        uint64_t NonPagedPoolUsage{0};
+        std::u16string_view ImageName; ///< UTF-16 file name, pointing into the parsed buffer; empty for the idle process.
+    };
+
+    /// @brief The pointer size of the Windows that filled a SystemProcessInformation buffer.
+    enum class SystemProcessInformationLayout
+    {
+        X86, ///< 32-bit Windows, or a 32-bit process on 64-bit Windows.
+        X64, ///< 64-bit process on 64-bit Windows.
+    };
+
+    /// @brief The layout of the buffers NtQuerySystemInformation fills for this build.
+    constexpr SystemProcessInformationLayout NATIVE_SYSTEM_PROCESS_INFORMATION_LAYOUT =
+        (sizeof(void *) == 8) ? SystemProcessInformationLayout::X64 : SystemProcessInformationLayout::X86;
+
+    /// @brief Parse the entries of a SystemProcessInformation buffer.
+    /// @param buffer The bytes written by NtQuerySystemInformation.
+    /// @param bufferAddress Address the buffer had when it was filled: the image names are stored
+    ///        as absolute pointers into it. Pass the address of a buffer loaded from a capture here.
+    /// @param layout Layout of the buffer; a capture may come from another platform than the parser's.
+    /// @param records Receives one record per process (cleared first). The image names point into @p buffer.
+    /// @return false if the buffer is malformed (an entry does not fit); @p records then holds the
+    ///         entries before the broken one.
+    bool ParseSystemProcessInformation(std::span<const std::byte> buffer, uint64_t bufferAddress, SystemProcessInformationLayout layout, std::vector<SystemProcessRecord> &records);
+
+    /// @brief Parse a buffer that was filled at its current address by this build.
+    inline bool ParseSystemProcessInformation(std::span<const std::byte> buffer, std::vector<SystemProcessRecord> &records)
+    {
+        return ParseSystemProcessInformation(buffer, reinterpret_cast<uintptr_t>(buffer.data()), NATIVE_SYSTEM_PROCESS_INFORMATION_LAYOUT, records);
+    }
+
+} // namespace pserv
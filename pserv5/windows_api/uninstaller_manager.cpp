@@ -73,8 +73,8 @@ namespace pserv
 
             const auto displayVersion = GetRegistryStringValue(hSubKey.get(), L"DisplayVersion");
             const auto uninstallString = GetRegistryStringValue(hSubKey.get(), L"UninstallString");
-            const auto stableId{InstalledProgramInfo::GetStableID(displayName, displayVersion, uninstallString)};
-            auto ipi = doc->GetByStableId<InstalledProgramInfo>(stableId);
+            const auto stableKey{InstalledProgramInfo::GetStableKey(displayName, displayVersion, uninstallString)};
+            auto ipi = doc->GetByStableKey<InstalledProgramInfo>(stableKey);
             if (ipi == nullptr)
             {
                 ipi = doc->Append<InstalledProgramInfo>(DBG_NEW InstalledProgramInfo{displayName, displayVersion, uninstallString});
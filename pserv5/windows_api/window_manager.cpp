@@ -35,8 +35,8 @@ namespace pserv
             return TRUE;
         }
         
-        const auto stableId{WindowInfo::GetStableID(hwnd)};
-        auto info = context->doc->GetByStableId<WindowInfo>(stableId);
+        const auto stableKey{WindowInfo::GetStableKey(hwnd)};
+        auto info = context->doc->GetByStableKey<WindowInfo>(stableKey);
         if (info == nullptr)
         {
             info = context->doc->Append<WindowInfo>(DBG_NEW WindowInfo{hwnd});